@@ -30,6 +30,10 @@ struct Array {
 #define array_free(array) \
   ((void)((array) ? (array_delete((void*)(array)), (array) = 0) : 0))
 
+// clear [array] without releasing storage
+#define array_clear(array) \
+  ((void)((array) ? (array_meta(array)->size = 0) : 0))
+
 // size of [array]
 #define array_size(array) \
   ((array) ? array_meta(array)->size : 0)
@@ -0,0 +1,320 @@
+#include <string.h> // memcpy
+
+#include "batch32.h"
+
+typedef Float32 (*Operator)(Context*, Float32, Float32);
+
+// Evaluate a single lane with the scalar function in a scratch context so the
+// exceptions it raises end up in the per-lane mask.
+static Float32 batch_lane(Context *scratch, Operator op, Float32 a, Float32 b, Uint8 *exceptions, Size *roundings) {
+  context_reset(scratch);
+  const Float32 r = op(scratch, a, b);
+  *exceptions = scratch->raised;
+  *roundings += scratch->roundings;
+  return r;
+}
+
+static Size batch_scalar(Context *scratch, Operator op, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions) {
+  Size roundings = 0;
+  for (Size i = 0; i < count; i++) {
+    r[i] = batch_lane(scratch, op, a[i], b[i], &exceptions[i], &roundings);
+  }
+  return roundings;
+}
+
+#if defined(__GNUC__)
+
+#define LANES 8
+
+typedef Uint32 U32 __attribute__((vector_size(LANES * 4)));
+typedef Sint32 S32 __attribute__((vector_size(LANES * 4)));
+typedef Uint64 U64 __attribute__((vector_size(LANES * 8)));
+typedef Sint64 S64 __attribute__((vector_size(LANES * 8)));
+typedef double F64 __attribute__((vector_size(LANES * 8)));
+typedef Uint8 U8 __attribute__((vector_size(LANES)));
+
+// The kernels below only handle lanes where both operands are normal and the
+// exponent before rounding is in [0, 0xfc], so float32_round_and_pack can
+// neither overflow nor produce a subnormal. Every lane is computed regardless
+// and [ok] marks the ones that met those conditions.
+typedef struct Lanes Lanes;
+
+struct Lanes {
+  U32 bits;
+  U32 inexact; ///< All ones where rounding was inexact.
+  S32 ok;      ///< All ones where the lane is valid.
+};
+
+#define KERNEL static inline __attribute__((always_inline))
+
+KERNEL U32 load(const Float32 *a) {
+  U32 v;
+  memcpy(&v, a, sizeof v);
+  return v;
+}
+
+KERNEL S32 is_normal(U32 exp) {
+  return exp - 1 < 0xfe;
+}
+
+KERNEL S32 in_range(S32 exp) {
+  return (exp >= 0) & (exp <= 0xfc);
+}
+
+// rshr32 of every lane of [a] by [count], counts may exceed 31.
+KERNEL U32 rshr(U32 a, S32 count) {
+  const S32 bounded = ((count < 31) & count) | (~(count < 31) & 31);
+  const U32 shifted = (a >> (U32)bounded)
+    | ((U32)((a << (U32)((32 - bounded) & 31)) != 0) & 1);
+  const S32 zero = count == 0;
+  const S32 large = count >= 32;
+  return ((U32)zero & a)
+       | ((U32)large & (U32)(a != 0) & 1)
+       | ((U32)~(zero | large) & shifted);
+}
+
+// float32_round_and_pack of lanes known to be in range.
+KERNEL U32 round_and_pack(Round round, U32 sign, S32 exp, U32 sig, U32 *inexact) {
+  const U32 zero = { 0 };
+  U32 increment = zero;
+  if (round == ROUND_NEAREST_EVEN) {
+    increment = zero + 0x40;
+  } else if (round == ROUND_DOWN) {
+    increment = (U32)(sign != 0) & 0x7f;
+  } else if (round == ROUND_UP) {
+    increment = (U32)(sign == 0) & 0x7f;
+  }
+  const U32 round_bits = sig & 0x7f;
+  *inexact = (U32)(round_bits != 0);
+  sig = (sig + increment) >> 7;
+  if (round == ROUND_NEAREST_EVEN) {
+    sig &= ~((U32)(round_bits == 0x40) & 1);
+  }
+  return (sign << 31) + ((U32)exp << 23) + sig;
+}
+
+// Count leading zeros of non-zero lanes less than 2^31 by way of the exponent
+// of their exact conversion to double.
+KERNEL S32 count_leading_zeros(U32 a) {
+  const F64 d = __builtin_convertvector((S32)a, F64);
+  const U64 bits = (U64)d;
+  return 31 - (__builtin_convertvector(bits >> 52, S32) - 1023);
+}
+
+// float32_add_sig of lanes with equal signs, [x] being the larger magnitude.
+KERNEL void add_sig(Round round, U32 sign, U32 x, U32 y, Lanes *out) {
+  const U32 x_exp = (x >> 23) & 0xff;
+  const U32 y_exp = (y >> 23) & 0xff;
+  const U32 x_sig = ((x & 0x007fffff) << 6) | 0x20000000;
+  const U32 y_sig = rshr(((y & 0x007fffff) << 6) | 0x20000000, (S32)(x_exp - y_exp));
+  U32 sig = (x_sig + y_sig) << 1;
+  S32 exp = (S32)x_exp - 1;
+  const S32 carry = (S32)sig < 0;
+  sig = ((U32)carry & (x_sig + y_sig)) | ((U32)~carry & sig);
+  exp -= carry;
+  out->bits = round_and_pack(round, sign, exp, sig, &out->inexact);
+  out->ok = is_normal(x_exp) & is_normal(y_exp) & in_range(exp);
+}
+
+// float32_sub_sig of lanes with equal signs, [x] being the larger magnitude.
+KERNEL void sub_sig(Round round, U32 sign, U32 x, U32 y, Lanes *out) {
+  const U32 x_exp = (x >> 23) & 0xff;
+  const U32 y_exp = (y >> 23) & 0xff;
+  const U32 x_sig = ((x & 0x007fffff) << 7) | 0x40000000;
+  const U32 y_sig = rshr(((y & 0x007fffff) << 7) | 0x40000000, (S32)(x_exp - y_exp));
+  const S32 equal = x == y;
+  // Equal magnitudes give an exact zero, keep the lane valid meanwhile.
+  U32 sig = (x_sig - y_sig) | ((U32)equal & 1);
+  const S32 shift = count_leading_zeros(sig) - 1;
+  const S32 exp = (S32)x_exp - 1 - shift;
+  sig <<= (U32)shift;
+  const U32 bits = round_and_pack(round, sign, exp, sig, &out->inexact);
+  const U32 zero = (U32){ 0 } + ((Uint32)(round == ROUND_DOWN) << 31);
+  out->bits = ((U32)equal & zero) | ((U32)~equal & bits);
+  out->inexact &= (U32)~equal;
+  out->ok = is_normal(x_exp) & is_normal(y_exp) & (equal | in_range(exp));
+}
+
+// a + b, both the sum and difference of magnitudes are computed and selected
+// by the signs.
+KERNEL void add_sig_or_sub_sig(Round round, U32 a, U32 b, Lanes *out) {
+  const U32 a_mag = a & 0x7fffffff;
+  const U32 b_mag = b & 0x7fffffff;
+  const S32 swap = b_mag > a_mag;
+  const U32 x = ((U32)swap & b_mag) | ((U32)~swap & a_mag);
+  const U32 y = ((U32)swap & a_mag) | ((U32)~swap & b_mag);
+  const U32 a_sign = a >> 31;
+  const S32 subtract = (a ^ b) >> 31 != 0;
+
+  Lanes sum;
+  Lanes difference;
+  add_sig(round, a_sign, x, y, &sum);
+  sub_sig(round, a_sign ^ ((U32)swap & 1), x, y, &difference);
+
+  out->bits = ((U32)subtract & difference.bits) | ((U32)~subtract & sum.bits);
+  out->inexact = ((U32)subtract & difference.inexact) | ((U32)~subtract & sum.inexact);
+  out->ok = (subtract & difference.ok) | (~subtract & sum.ok);
+}
+
+KERNEL void add_lanes(Round round, const Float32 *pa, const Float32 *pb, Lanes *out) {
+  add_sig_or_sub_sig(round, load(pa), load(pb), out);
+}
+
+// Subtraction is addition of b with its sign flipped.
+KERNEL void sub_lanes(Round round, const Float32 *pa, const Float32 *pb, Lanes *out) {
+  const U32 a = load(pa);
+  const U32 b = load(pb) ^ 0x80000000;
+  add_sig_or_sub_sig(round, a, b, out);
+}
+
+KERNEL void mul_lanes(Round round, const Float32 *pa, const Float32 *pb, Lanes *out) {
+  const U32 a = load(pa);
+  const U32 b = load(pb);
+  const U32 a_exp = (a >> 23) & 0xff;
+  const U32 b_exp = (b >> 23) & 0xff;
+  const U32 a_sig = ((a & 0x007fffff) | 0x00800000) << 7;
+  const U32 b_sig = ((b & 0x007fffff) | 0x00800000) << 8;
+  const U64 product = __builtin_convertvector(a_sig, U64) * __builtin_convertvector(b_sig, U64);
+  U32 sig = __builtin_convertvector(product >> 32, U32)
+    | ((U32)(__builtin_convertvector(product, U32) != 0) & 1);
+  const S32 small = sig < 0x40000000;
+  const S32 exp = (S32)a_exp + (S32)b_exp - 0x7f + small;
+  sig += sig & (U32)small;
+  out->bits = round_and_pack(round, (a ^ b) >> 31, exp, sig, &out->inexact);
+  out->ok = is_normal(a_exp) & is_normal(b_exp) & in_range(exp);
+}
+
+// The quotient of the significands is computed in double precision, where the
+// dividend and divisor are exact, and corrected to the truncated quotient.
+KERNEL void div_lanes(Round round, const Float32 *pa, const Float32 *pb, Lanes *out) {
+  const U32 a = load(pa);
+  const U32 b = load(pb);
+  const U32 a_exp = (a >> 23) & 0xff;
+  const U32 b_exp = (b >> 23) & 0xff;
+  const U32 a_sig = (a & 0x007fffff) | 0x00800000;
+  const U32 b_sig = (b & 0x007fffff) | 0x00800000;
+  const S32 smaller = a_sig < b_sig;
+  const S32 exp = (S32)a_exp - (S32)b_exp + 0x7e + smaller;
+  U64 dividend = __builtin_convertvector(a_sig, U64) << 30;
+  dividend += dividend & (U64)__builtin_convertvector(smaller, S64);
+  const U64 divisor = __builtin_convertvector(b_sig, U64);
+  const F64 quotient = __builtin_convertvector((S32)a_sig, F64)
+    * 0x1p30
+    * __builtin_convertvector(((S32)smaller & 1) + 1, F64)
+    / __builtin_convertvector((S32)b_sig, F64);
+  U32 sig = (U32)__builtin_convertvector(quotient, S32);
+  U64 product = __builtin_convertvector(sig, U64) * divisor;
+  // Rounding of the quotient may have crossed up to the next integer.
+  const S64 over = product > dividend;
+  sig += (U32)__builtin_convertvector(over, S32);
+  product -= (U64)over & divisor;
+  const S32 exact = __builtin_convertvector(product == dividend, S32);
+  sig |= (U32)(((sig & 0x3f) == 0) & ~exact) & 1;
+  out->bits = round_and_pack(round, (a ^ b) >> 31, exp, sig, &out->inexact);
+  out->ok = is_normal(a_exp) & is_normal(b_exp) & in_range(exp);
+}
+
+KERNEL Bool all_lanes(S32 mask) {
+  Uint64 words[LANES / 2];
+  memcpy(words, &mask, sizeof words);
+  Uint64 all = ~LIT64(0);
+  for (Size i = 0; i < LANES / 2; i++) {
+    all &= words[i];
+  }
+  return all == ~LIT64(0);
+}
+
+// Runs [kernel] over every full group of lanes, falling back to [op] for the
+// lanes it could not handle and for the remainder.
+#define BATCH(name, kernel, op) \
+  static Size name(Context *ctx, Context *scratch, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions) { \
+    const Round round = ctx->config.round; \
+    U32 inexact_lanes = { 0 }; \
+    Size roundings = 0; \
+    Size i = 0; \
+    for (; i + LANES <= count; i += LANES) { \
+      Lanes lanes; \
+      kernel(round, a + i, b + i, &lanes); \
+      const U32 inexact = lanes.inexact & (U32)lanes.ok; \
+      const U8 raised = __builtin_convertvector(inexact & EXCEPTION_INEXACT, U8); \
+      memcpy(r + i, &lanes.bits, sizeof lanes.bits); \
+      memcpy(exceptions + i, &raised, sizeof raised); \
+      inexact_lanes -= inexact; \
+      if (!all_lanes(lanes.ok)) { \
+        Sint32 ok[LANES]; \
+        memcpy(ok, &lanes.ok, sizeof ok); \
+        for (Size l = 0; l < LANES; l++) { \
+          if (!ok[l]) { \
+            r[i + l] = batch_lane(scratch, op, a[i + l], b[i + l], &exceptions[i + l], &roundings); \
+          } \
+        } \
+      } \
+    } \
+    for (Size l = 0; l < LANES; l++) { \
+      roundings += inexact_lanes[l]; \
+    } \
+    return roundings + batch_scalar(scratch, op, count - i, a + i, b + i, r + i, exceptions + i); \
+  }
+
+// Same as BATCH for when the scalar functions are faster.
+#define SCALAR(name, op) \
+  static Size name(Context *ctx, Context *scratch, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions) { \
+    (void)ctx; \
+    return batch_scalar(scratch, op, count, a, b, r, exceptions); \
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+// Without AVX2 there are no per-lane variable shifts, which aligning the
+// operands of an addition depends on, and the compiler's emulation of them is
+// slower than the scalar functions.
+SCALAR(add_vector, float32_add)
+SCALAR(sub_vector, float32_sub)
+#else
+BATCH(add_vector, add_lanes, float32_add)
+BATCH(sub_vector, sub_lanes, float32_sub)
+#endif
+BATCH(mul_vector, mul_lanes, float32_mul)
+BATCH(div_vector, div_lanes, float32_div)
+
+#if defined(__x86_64__) || defined(__i386__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+BATCH(add_avx2, add_lanes, float32_add)
+BATCH(sub_avx2, sub_lanes, float32_sub)
+BATCH(mul_avx2, mul_lanes, float32_mul)
+BATCH(div_avx2, div_lanes, float32_div)
+#pragma GCC pop_options
+
+#define DISPATCH(name) \
+  (__builtin_cpu_supports("avx2") ? name##_avx2 : name##_vector)
+#else
+#define DISPATCH(name) \
+  name##_vector
+#endif
+
+#define BATCH_ENTRY(name, op, counter) \
+  void float32_##name##_batch(Context *ctx, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions) { \
+    Context scratch; \
+    context_copy(&scratch, ctx); \
+    STATS(ctx, operations[counter], count); \
+    ctx->roundings += DISPATCH(name)(ctx, &scratch, count, a, b, r, exceptions); \
+    context_free(&scratch); \
+  }
+
+#else
+
+#define BATCH_ENTRY(name, op, counter) \
+  void float32_##name##_batch(Context *ctx, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions) { \
+    Context scratch; \
+    context_copy(&scratch, ctx); \
+    STATS(ctx, operations[counter], count); \
+    ctx->roundings += batch_scalar(&scratch, op, count, a, b, r, exceptions); \
+    context_free(&scratch); \
+  }
+
+#endif
+
+BATCH_ENTRY(add, float32_add, STATS_ADD)
+BATCH_ENTRY(sub, float32_sub, STATS_SUB)
+BATCH_ENTRY(mul, float32_mul, STATS_MUL)
+BATCH_ENTRY(div, float32_div, STATS_DIV)
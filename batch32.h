@@ -0,0 +1,21 @@
+#ifndef BATCH32_H
+#define BATCH32_H
+#include "float32.h"
+
+// Element-wise arithmetic over contiguous arrays, r[i] = a[i] op b[i].
+//
+// Results are bit-exact with the scalar functions under the rounding and
+// tininess mode of the context. The exceptions raised for element i are
+// written to exceptions[i] instead of being raised in the context, roundings
+// are accumulated into the context as usual, and no operations are recorded.
+//
+// Where the compiler supports vector extensions, groups of lanes whose
+// operands and result are all normal go through a vectorized significand
+// pipeline (AVX2 when the CPU has it, otherwise the baseline instruction set)
+// and every other lane falls back to the scalar function.
+void float32_add_batch(Context*, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions);
+void float32_sub_batch(Context*, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions);
+void float32_mul_batch(Context*, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions);
+void float32_div_batch(Context*, Size count, const Float32 *a, const Float32 *b, Float32 *r, Uint8 *exceptions);
+
+#endif // BATCH32_H
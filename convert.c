@@ -0,0 +1,157 @@
+#include "convert.h"
+
+// Exceptions and roundings of the scalar function just evaluated in [scratch],
+// which is reset for the next element.
+static Uint8 scratch_raised(Context *scratch, Size *roundings) {
+  const Uint8 raised = scratch->raised;
+  *roundings += scratch->roundings;
+  context_reset(scratch);
+  return raised;
+}
+
+// Magnitudes below 2^24 and 2^53 respectively, which are exact. Neither zero
+// nor the sign is branched on, as both are common and random in quantized data.
+static inline Float32 float32_exact(Flag sign, Uint64 a) {
+  const Sint16 top = 63 - __builtin_clzll(a | 1);
+  const Float32 r = float32_pack(sign, 0x7f + top, (a << (23 - top)) & LIT32(0x007fffff));
+  return (Float32){r.bits & -(Uint32)(a != 0)};
+}
+
+static inline Float64 float64_exact(Flag sign, Uint64 a) {
+  const Sint16 top = 63 - __builtin_clzll(a | 1);
+  const Float64 r = float64_pack(sign, 0x3ff + top, (a << (52 - top)) & LIT64(0x000fffffffffffff));
+  return (Float64){r.bits & -(Uint64)(a != 0)};
+}
+
+// [negative] tells whether the element x is below zero, which is never for the
+// unsigned types.
+#define FROM_INTEGER(Float, width, Int, name, precision, negative) \
+  void width##_from_##name##_batch(Context *ctx, Size count, const Int *a, Float *r, Uint8 *exceptions) { \
+    Context scratch; \
+    context_copy(&scratch, ctx); \
+    Size roundings = 0; \
+    for (Size i = 0; i < count; i++) { \
+      const Int x = a[i]; \
+      const Flag sign = negative; \
+      const Uint64 mask = -(Uint64)sign; \
+      const Uint64 magnitude = ((Uint64)x ^ mask) - mask; \
+      if (magnitude >> precision == 0) { \
+        r[i] = width##_exact(sign, magnitude); \
+        exceptions[i] = 0; \
+      } else { \
+        r[i] = width##_from_##name(&scratch, x); \
+        exceptions[i] = scratch_raised(&scratch, &roundings); \
+      } \
+    } \
+    ctx->roundings += roundings; \
+    STATS(ctx, operations[STATS_CONVERT], count); \
+    context_free(&scratch); \
+  }
+
+FROM_INTEGER(Float32, float32, Sint32, sint32, 24, x < 0)
+FROM_INTEGER(Float32, float32, Uint32, uint32, 24, 0)
+FROM_INTEGER(Float32, float32, Sint64, sint64, 24, x < 0)
+FROM_INTEGER(Float32, float32, Uint64, uint64, 24, 0)
+FROM_INTEGER(Float64, float64, Sint32, sint32, 53, x < 0)
+FROM_INTEGER(Float64, float64, Uint32, uint32, 53, 0)
+FROM_INTEGER(Float64, float64, Sint64, sint64, 53, x < 0)
+FROM_INTEGER(Float64, float64, Uint64, uint64, 53, 0)
+
+// The integer limits are those of the scalar functions.
+#define TO_INTEGER(Float, width, Int, name, max_positive, max_negative, invalid) \
+  void width##_to_##name##_batch(Context *ctx, Size count, const Float *a, Int *r, Uint8 *exceptions) { \
+    const Round round = ctx->config.round; \
+    Size roundings = 0; \
+    for (Size i = 0; i < count; i++) { \
+      r[i] = width##_to_integer(a[i], round, max_positive, max_negative, invalid, &exceptions[i]); \
+      roundings += exceptions[i] == EXCEPTION_INEXACT; \
+    } \
+    ctx->roundings += roundings; \
+    STATS(ctx, operations[STATS_CONVERT], count); \
+  }
+
+TO_INTEGER(Float32, float32, Sint32, sint32, LIT64(0x7fffffff), LIT64(0x80000000), LIT64(0x80000000))
+TO_INTEGER(Float32, float32, Uint32, uint32, LIT64(0xffffffff), 0, LIT64(0xffffffff))
+TO_INTEGER(Float32, float32, Sint64, sint64, LIT64(0x7fffffffffffffff), LIT64(0x8000000000000000), LIT64(0x8000000000000000))
+TO_INTEGER(Float32, float32, Uint64, uint64, LIT64(0xffffffffffffffff), 0, LIT64(0xffffffffffffffff))
+TO_INTEGER(Float64, float64, Sint32, sint32, LIT64(0x7fffffff), LIT64(0x80000000), LIT64(0x80000000))
+TO_INTEGER(Float64, float64, Uint32, uint32, LIT64(0xffffffff), 0, LIT64(0xffffffff))
+TO_INTEGER(Float64, float64, Sint64, sint64, LIT64(0x7fffffffffffffff), LIT64(0x8000000000000000), LIT64(0x8000000000000000))
+TO_INTEGER(Float64, float64, Uint64, uint64, LIT64(0xffffffffffffffff), 0, LIT64(0xffffffffffffffff))
+
+void float64_to_float32_batch(Context *ctx, Size count, const Float64 *a, Float32 *r, Uint8 *exceptions) {
+  const Round round = ctx->config.round;
+  Context scratch;
+  context_copy(&scratch, ctx);
+  Size roundings = 0;
+  for (Size i = 0; i < count; i++) {
+    const Sint16 a_exp = float64_exp(a[i]);
+    const Uint64 a_sig = float64_fract(a[i]);
+    const Flag a_sign = float64_sign(a[i]);
+    if ((a[i].bits << 1) == 0) {
+      r[i] = float32_pack(a_sign, 0, 0);
+      exceptions[i] = 0;
+      continue;
+    }
+    if (0x381 <= a_exp && a_exp <= 0x47e) {
+      // A normal float32 before rounding, the 29 bits dropped decide it. A
+      // carry out of the significand correctly bumps the exponent.
+      const Uint64 rest = a_sig & LIT64(0x1fffffff);
+      const Uint32 bits = float32_pack(a_sign, a_exp - 0x380, a_sig >> 29).bits;
+      Flag up = 0;
+      switch (round) {
+      case ROUND_NEAREST_EVEN:
+        up = rest > LIT64(0x10000000) || (rest == LIT64(0x10000000) && (bits & 1));
+        break;
+      case ROUND_TO_ZERO:
+        break;
+      case ROUND_DOWN:
+        up = a_sign & (rest != 0);
+        break;
+      case ROUND_UP:
+        up = (a_sign ^ 1) & (rest != 0);
+        break;
+      }
+      // Rounding up to infinity overflows, which the scalar function raises.
+      if (((bits + up) & LIT32(0x7f800000)) != LIT32(0x7f800000)) {
+        r[i] = (Float32){bits + up};
+        exceptions[i] = rest ? EXCEPTION_INEXACT : 0;
+        roundings += rest != 0;
+        continue;
+      }
+    }
+    r[i] = float64_to_float32(&scratch, a[i]);
+    exceptions[i] = scratch_raised(&scratch, &roundings);
+  }
+  ctx->roundings += roundings;
+  STATS(ctx, operations[STATS_CONVERT], count);
+  context_free(&scratch);
+}
+
+void float32_to_float64_batch(Context *ctx, Size count, const Float32 *a, Float64 *r, Uint8 *exceptions) {
+  Context scratch;
+  context_copy(&scratch, ctx);
+  Size roundings = 0;
+  for (Size i = 0; i < count; i++) {
+    const Sint16 a_exp = float32_exp(a[i]);
+    const Uint32 a_sig = float32_fract(a[i]);
+    const Flag a_sign = float32_sign(a[i]);
+    exceptions[i] = 0;
+    if (a_exp && a_exp != 0xff) {
+      r[i] = float64_pack(a_sign, a_exp + 0x380, (Uint64)a_sig << 29);
+    } else if (!a_exp && !a_sig) {
+      r[i] = float64_pack(a_sign, 0, 0);
+    } else if (!a_exp) {
+      r[i] = float64_exact(a_sign, a_sig);
+      r[i].bits -= (Uint64)149 << 52;
+    } else if (!a_sig) {
+      r[i] = float64_pack(a_sign, 0x7ff, 0);
+    } else {
+      r[i] = float32_to_float64(&scratch, a[i]);
+      exceptions[i] = scratch_raised(&scratch, &roundings);
+    }
+  }
+  ctx->roundings += roundings;
+  STATS(ctx, operations[STATS_CONVERT], count);
+  context_free(&scratch);
+}
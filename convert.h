@@ -0,0 +1,37 @@
+#ifndef CONVERT_H
+#define CONVERT_H
+#include "float32.h"
+#include "float64.h"
+
+// Element-wise conversions over contiguous arrays, r[i] = convert(a[i]).
+//
+// The conventions are those of batch32.h: results are bit-exact with the
+// scalar functions under the rounding mode of the context, the exceptions
+// raised for element i are written to exceptions[i], roundings are accumulated
+// into the context and no operations are recorded.
+//
+// Integers the format holds exactly, every conversion to an integer, widening
+// of anything but NaNs and narrowing to a normal float32 are done in line, the
+// remaining elements go through the scalar function.
+void float32_from_sint32_batch(Context*, Size count, const Sint32 *a, Float32 *r, Uint8 *exceptions);
+void float32_from_uint32_batch(Context*, Size count, const Uint32 *a, Float32 *r, Uint8 *exceptions);
+void float32_from_sint64_batch(Context*, Size count, const Sint64 *a, Float32 *r, Uint8 *exceptions);
+void float32_from_uint64_batch(Context*, Size count, const Uint64 *a, Float32 *r, Uint8 *exceptions);
+void float64_from_sint32_batch(Context*, Size count, const Sint32 *a, Float64 *r, Uint8 *exceptions);
+void float64_from_uint32_batch(Context*, Size count, const Uint32 *a, Float64 *r, Uint8 *exceptions);
+void float64_from_sint64_batch(Context*, Size count, const Sint64 *a, Float64 *r, Uint8 *exceptions);
+void float64_from_uint64_batch(Context*, Size count, const Uint64 *a, Float64 *r, Uint8 *exceptions);
+
+void float32_to_sint32_batch(Context*, Size count, const Float32 *a, Sint32 *r, Uint8 *exceptions);
+void float32_to_uint32_batch(Context*, Size count, const Float32 *a, Uint32 *r, Uint8 *exceptions);
+void float32_to_sint64_batch(Context*, Size count, const Float32 *a, Sint64 *r, Uint8 *exceptions);
+void float32_to_uint64_batch(Context*, Size count, const Float32 *a, Uint64 *r, Uint8 *exceptions);
+void float64_to_sint32_batch(Context*, Size count, const Float64 *a, Sint32 *r, Uint8 *exceptions);
+void float64_to_uint32_batch(Context*, Size count, const Float64 *a, Uint32 *r, Uint8 *exceptions);
+void float64_to_sint64_batch(Context*, Size count, const Float64 *a, Sint64 *r, Uint8 *exceptions);
+void float64_to_uint64_batch(Context*, Size count, const Float64 *a, Uint64 *r, Uint8 *exceptions);
+
+void float64_to_float32_batch(Context*, Size count, const Float64 *a, Float32 *r, Uint8 *exceptions);
+void float32_to_float64_batch(Context*, Size count, const Float32 *a, Float64 *r, Uint8 *exceptions);
+
+#endif // CONVERT_H
@@ -0,0 +1,1410 @@
+#include "decimal.h"
+#include "float32.h"
+#include "float64.h"
+#include "uint128.h"
+
+// A positive value sig * 2^exp, where the leading bit of sig is bit 63 and any
+// bits below it are truncated, in which case sticky is set.
+typedef struct Extended Extended;
+
+struct Extended {
+  Uint64 sig;
+  Sint32 exp;
+  Flag sticky;
+};
+
+typedef enum Parsed Parsed;
+
+enum Parsed {
+  PARSED_NONE,
+  PARSED_ZERO,
+  PARSED_FINITE,
+  PARSED_INF,
+  PARSED_NAN
+};
+
+// Decimal literals whose value is 10^LITERAL_MAX or more overflow, those below
+// 10^LITERAL_MIN underflow to zero or the smallest subnormal.
+#define LITERAL_MAX 310
+#define LITERAL_MIN -345
+
+// Values that round to infinity and to zero or the smallest subnormal.
+#define EXTENDED_HUGE (Extended){LIT64(0x8000000000000000), 2000, 1}
+#define EXTENDED_TINY (Extended){LIT64(0x8000000000000000), -2000, 1}
+
+// Normalized 128-bit 5^q truncated, which is also the significand of 10^q, for
+// every q of a 19 digit literal within the limits above and every power of ten
+// formatting a float64 takes. It is exact for q in [0, 55].
+#define POW5_MIN -364
+#define POW5_MAX 326
+static const Uint64 POW5[POW5_MAX - POW5_MIN + 1][2] = {
+  {LIT64(0xe1afa13afbd14d6d), LIT64(0x82189c09a3a1ec21)}, // 5^-364
+  {LIT64(0x8d0dc4c4dd62d064), LIT64(0x714f618606453394)}, // 5^-363
+  {LIT64(0xb05135f614bb847d), LIT64(0x8da339e787d6807a)}, // 5^-362
+  {LIT64(0xdc65837399ea659c), LIT64(0xf10c086169cc2098)}, // 5^-361
+  {LIT64(0x89bf722840327f82), LIT64(0x16a7853ce21f945f)}, // 5^-360
+  {LIT64(0xac2f4eb2503f1f62), LIT64(0x9c51668c1aa77977)}, // 5^-359
+  {LIT64(0xd73b225ee44ee73b), LIT64(0x4365c02f215157d5)}, // 5^-358
+  {LIT64(0x8684f57b4eb15085), LIT64(0x0a1f981d74d2d6e5)}, // 5^-357
+  {LIT64(0xa82632da225da4a6), LIT64(0x4ca77e24d2078c9e)}, // 5^-356
+  {LIT64(0xd22fbf90aaf50dcf), LIT64(0xdfd15dae06896fc6)}, // 5^-355
+  {LIT64(0x835dd7ba6ad928a1), LIT64(0xebe2da8cc415e5db)}, // 5^-354
+  {LIT64(0xa4354da9058f72ca), LIT64(0x66db912ff51b5f52)}, // 5^-353
+  {LIT64(0xcd42a11346f34f7d), LIT64(0x0092757bf2623727)}, // 5^-352
+  {LIT64(0x8049a4ac0c5811ae), LIT64(0x205b896d777d6278)}, // 5^-351
+  {LIT64(0xa05c0dd70f6e1619), LIT64(0xa8726bc8d55cbb16)}, // 5^-350
+  {LIT64(0xc873114cd3499ba0), LIT64(0x128f06bb0ab3e9dc)}, // 5^-349
+  {LIT64(0xfa8fd5a0081c0288), LIT64(0x1732c869cd60e453)}, // 5^-348
+  {LIT64(0x9c99e58405118195), LIT64(0x0e7fbd42205c8eb4)}, // 5^-347
+  {LIT64(0xc3c05ee50655e1fa), LIT64(0x521fac92a873b261)}, // 5^-346
+  {LIT64(0xf4b0769e47eb5a78), LIT64(0xe6a797b752909ef9)}, // 5^-345
+  {LIT64(0x98ee4a22ecf3188b), LIT64(0x9028bed2939a635c)}, // 5^-344
+  {LIT64(0xbf29dcaba82fdeae), LIT64(0x7432ee873880fc33)}, // 5^-343
+  {LIT64(0xeef453d6923bd65a), LIT64(0x113faa2906a13b3f)}, // 5^-342
+  {LIT64(0x9558b4661b6565f8), LIT64(0x4ac7ca59a424c507)}, // 5^-341
+  {LIT64(0xbaaee17fa23ebf76), LIT64(0x5d79bcf00d2df649)}, // 5^-340
+  {LIT64(0xe95a99df8ace6f53), LIT64(0xf4d82c2c107973dc)}, // 5^-339
+  {LIT64(0x91d8a02bb6c10594), LIT64(0x79071b9b8a4be869)}, // 5^-338
+  {LIT64(0xb64ec836a47146f9), LIT64(0x9748e2826cdee284)}, // 5^-337
+  {LIT64(0xe3e27a444d8d98b7), LIT64(0xfd1b1b2308169b25)}, // 5^-336
+  {LIT64(0x8e6d8c6ab0787f72), LIT64(0xfe30f0f5e50e20f7)}, // 5^-335
+  {LIT64(0xb208ef855c969f4f), LIT64(0xbdbd2d335e51a935)}, // 5^-334
+  {LIT64(0xde8b2b66b3bc4723), LIT64(0xad2c788035e61382)}, // 5^-333
+  {LIT64(0x8b16fb203055ac76), LIT64(0x4c3bcb5021afcc31)}, // 5^-332
+  {LIT64(0xaddcb9e83c6b1793), LIT64(0xdf4abe242a1bbf3d)}, // 5^-331
+  {LIT64(0xd953e8624b85dd78), LIT64(0xd71d6dad34a2af0d)}, // 5^-330
+  {LIT64(0x87d4713d6f33aa6b), LIT64(0x8672648c40e5ad68)}, // 5^-329
+  {LIT64(0xa9c98d8ccb009506), LIT64(0x680efdaf511f18c2)}, // 5^-328
+  {LIT64(0xd43bf0effdc0ba48), LIT64(0x0212bd1b2566def2)}, // 5^-327
+  {LIT64(0x84a57695fe98746d), LIT64(0x014bb630f7604b57)}, // 5^-326
+  {LIT64(0xa5ced43b7e3e9188), LIT64(0x419ea3bd35385e2d)}, // 5^-325
+  {LIT64(0xcf42894a5dce35ea), LIT64(0x52064cac828675b9)}, // 5^-324
+  {LIT64(0x818995ce7aa0e1b2), LIT64(0x7343efebd1940993)}, // 5^-323
+  {LIT64(0xa1ebfb4219491a1f), LIT64(0x1014ebe6c5f90bf8)}, // 5^-322
+  {LIT64(0xca66fa129f9b60a6), LIT64(0xd41a26e077774ef6)}, // 5^-321
+  {LIT64(0xfd00b897478238d0), LIT64(0x8920b098955522b4)}, // 5^-320
+  {LIT64(0x9e20735e8cb16382), LIT64(0x55b46e5f5d5535b0)}, // 5^-319
+  {LIT64(0xc5a890362fddbc62), LIT64(0xeb2189f734aa831d)}, // 5^-318
+  {LIT64(0xf712b443bbd52b7b), LIT64(0xa5e9ec7501d523e4)}, // 5^-317
+  {LIT64(0x9a6bb0aa55653b2d), LIT64(0x47b233c92125366e)}, // 5^-316
+  {LIT64(0xc1069cd4eabe89f8), LIT64(0x999ec0bb696e840a)}, // 5^-315
+  {LIT64(0xf148440a256e2c76), LIT64(0xc00670ea43ca250d)}, // 5^-314
+  {LIT64(0x96cd2a865764dbca), LIT64(0x380406926a5e5728)}, // 5^-313
+  {LIT64(0xbc807527ed3e12bc), LIT64(0xc605083704f5ecf2)}, // 5^-312
+  {LIT64(0xeba09271e88d976b), LIT64(0xf7864a44c633682e)}, // 5^-311
+  {LIT64(0x93445b8731587ea3), LIT64(0x7ab3ee6afbe0211d)}, // 5^-310
+  {LIT64(0xb8157268fdae9e4c), LIT64(0x5960ea05bad82964)}, // 5^-309
+  {LIT64(0xe61acf033d1a45df), LIT64(0x6fb92487298e33bd)}, // 5^-308
+  {LIT64(0x8fd0c16206306bab), LIT64(0xa5d3b6d479f8e056)}, // 5^-307
+  {LIT64(0xb3c4f1ba87bc8696), LIT64(0x8f48a4899877186c)}, // 5^-306
+  {LIT64(0xe0b62e2929aba83c), LIT64(0x331acdabfe94de87)}, // 5^-305
+  {LIT64(0x8c71dcd9ba0b4925), LIT64(0x9ff0c08b7f1d0b14)}, // 5^-304
+  {LIT64(0xaf8e5410288e1b6f), LIT64(0x07ecf0ae5ee44dd9)}, // 5^-303
+  {LIT64(0xdb71e91432b1a24a), LIT64(0xc9e82cd9f69d6150)}, // 5^-302
+  {LIT64(0x892731ac9faf056e), LIT64(0xbe311c083a225cd2)}, // 5^-301
+  {LIT64(0xab70fe17c79ac6ca), LIT64(0x6dbd630a48aaf406)}, // 5^-300
+  {LIT64(0xd64d3d9db981787d), LIT64(0x092cbbccdad5b108)}, // 5^-299
+  {LIT64(0x85f0468293f0eb4e), LIT64(0x25bbf56008c58ea5)}, // 5^-298
+  {LIT64(0xa76c582338ed2621), LIT64(0xaf2af2b80af6f24e)}, // 5^-297
+  {LIT64(0xd1476e2c07286faa), LIT64(0x1af5af660db4aee1)}, // 5^-296
+  {LIT64(0x82cca4db847945ca), LIT64(0x50d98d9fc890ed4d)}, // 5^-295
+  {LIT64(0xa37fce126597973c), LIT64(0xe50ff107bab528a0)}, // 5^-294
+  {LIT64(0xcc5fc196fefd7d0c), LIT64(0x1e53ed49a96272c8)}, // 5^-293
+  {LIT64(0xff77b1fcbebcdc4f), LIT64(0x25e8e89c13bb0f7a)}, // 5^-292
+  {LIT64(0x9faacf3df73609b1), LIT64(0x77b191618c54e9ac)}, // 5^-291
+  {LIT64(0xc795830d75038c1d), LIT64(0xd59df5b9ef6a2417)}, // 5^-290
+  {LIT64(0xf97ae3d0d2446f25), LIT64(0x4b0573286b44ad1d)}, // 5^-289
+  {LIT64(0x9becce62836ac577), LIT64(0x4ee367f9430aec32)}, // 5^-288
+  {LIT64(0xc2e801fb244576d5), LIT64(0x229c41f793cda73f)}, // 5^-287
+  {LIT64(0xf3a20279ed56d48a), LIT64(0x6b43527578c1110f)}, // 5^-286
+  {LIT64(0x9845418c345644d6), LIT64(0x830a13896b78aaa9)}, // 5^-285
+  {LIT64(0xbe5691ef416bd60c), LIT64(0x23cc986bc656d553)}, // 5^-284
+  {LIT64(0xedec366b11c6cb8f), LIT64(0x2cbfbe86b7ec8aa8)}, // 5^-283
+  {LIT64(0x94b3a202eb1c3f39), LIT64(0x7bf7d71432f3d6a9)}, // 5^-282
+  {LIT64(0xb9e08a83a5e34f07), LIT64(0xdaf5ccd93fb0cc53)}, // 5^-281
+  {LIT64(0xe858ad248f5c22c9), LIT64(0xd1b3400f8f9cff68)}, // 5^-280
+  {LIT64(0x91376c36d99995be), LIT64(0x23100809b9c21fa1)}, // 5^-279
+  {LIT64(0xb58547448ffffb2d), LIT64(0xabd40a0c2832a78a)}, // 5^-278
+  {LIT64(0xe2e69915b3fff9f9), LIT64(0x16c90c8f323f516c)}, // 5^-277
+  {LIT64(0x8dd01fad907ffc3b), LIT64(0xae3da7d97f6792e3)}, // 5^-276
+  {LIT64(0xb1442798f49ffb4a), LIT64(0x99cd11cfdf41779c)}, // 5^-275
+  {LIT64(0xdd95317f31c7fa1d), LIT64(0x40405643d711d583)}, // 5^-274
+  {LIT64(0x8a7d3eef7f1cfc52), LIT64(0x482835ea666b2572)}, // 5^-273
+  {LIT64(0xad1c8eab5ee43b66), LIT64(0xda3243650005eecf)}, // 5^-272
+  {LIT64(0xd863b256369d4a40), LIT64(0x90bed43e40076a82)}, // 5^-271
+  {LIT64(0x873e4f75e2224e68), LIT64(0x5a7744a6e804a291)}, // 5^-270
+  {LIT64(0xa90de3535aaae202), LIT64(0x711515d0a205cb36)}, // 5^-269
+  {LIT64(0xd3515c2831559a83), LIT64(0x0d5a5b44ca873e03)}, // 5^-268
+  {LIT64(0x8412d9991ed58091), LIT64(0xe858790afe9486c2)}, // 5^-267
+  {LIT64(0xa5178fff668ae0b6), LIT64(0x626e974dbe39a872)}, // 5^-266
+  {LIT64(0xce5d73ff402d98e3), LIT64(0xfb0a3d212dc8128f)}, // 5^-265
+  {LIT64(0x80fa687f881c7f8e), LIT64(0x7ce66634bc9d0b99)}, // 5^-264
+  {LIT64(0xa139029f6a239f72), LIT64(0x1c1fffc1ebc44e80)}, // 5^-263
+  {LIT64(0xc987434744ac874e), LIT64(0xa327ffb266b56220)}, // 5^-262
+  {LIT64(0xfbe9141915d7a922), LIT64(0x4bf1ff9f0062baa8)}, // 5^-261
+  {LIT64(0x9d71ac8fada6c9b5), LIT64(0x6f773fc3603db4a9)}, // 5^-260
+  {LIT64(0xc4ce17b399107c22), LIT64(0xcb550fb4384d21d3)}, // 5^-259
+  {LIT64(0xf6019da07f549b2b), LIT64(0x7e2a53a146606a48)}, // 5^-258
+  {LIT64(0x99c102844f94e0fb), LIT64(0x2eda7444cbfc426d)}, // 5^-257
+  {LIT64(0xc0314325637a1939), LIT64(0xfa911155fefb5308)}, // 5^-256
+  {LIT64(0xf03d93eebc589f88), LIT64(0x793555ab7eba27ca)}, // 5^-255
+  {LIT64(0x96267c7535b763b5), LIT64(0x4bc1558b2f3458de)}, // 5^-254
+  {LIT64(0xbbb01b9283253ca2), LIT64(0x9eb1aaedfb016f16)}, // 5^-253
+  {LIT64(0xea9c227723ee8bcb), LIT64(0x465e15a979c1cadc)}, // 5^-252
+  {LIT64(0x92a1958a7675175f), LIT64(0x0bfacd89ec191ec9)}, // 5^-251
+  {LIT64(0xb749faed14125d36), LIT64(0xcef980ec671f667b)}, // 5^-250
+  {LIT64(0xe51c79a85916f484), LIT64(0x82b7e12780e7401a)}, // 5^-249
+  {LIT64(0x8f31cc0937ae58d2), LIT64(0xd1b2ecb8b0908810)}, // 5^-248
+  {LIT64(0xb2fe3f0b8599ef07), LIT64(0x861fa7e6dcb4aa15)}, // 5^-247
+  {LIT64(0xdfbdcece67006ac9), LIT64(0x67a791e093e1d49a)}, // 5^-246
+  {LIT64(0x8bd6a141006042bd), LIT64(0xe0c8bb2c5c6d24e0)}, // 5^-245
+  {LIT64(0xaecc49914078536d), LIT64(0x58fae9f773886e18)}, // 5^-244
+  {LIT64(0xda7f5bf590966848), LIT64(0xaf39a475506a899e)}, // 5^-243
+  {LIT64(0x888f99797a5e012d), LIT64(0x6d8406c952429603)}, // 5^-242
+  {LIT64(0xaab37fd7d8f58178), LIT64(0xc8e5087ba6d33b83)}, // 5^-241
+  {LIT64(0xd5605fcdcf32e1d6), LIT64(0xfb1e4a9a90880a64)}, // 5^-240
+  {LIT64(0x855c3be0a17fcd26), LIT64(0x5cf2eea09a55067f)}, // 5^-239
+  {LIT64(0xa6b34ad8c9dfc06f), LIT64(0xf42faa48c0ea481e)}, // 5^-238
+  {LIT64(0xd0601d8efc57b08b), LIT64(0xf13b94daf124da26)}, // 5^-237
+  {LIT64(0x823c12795db6ce57), LIT64(0x76c53d08d6b70858)}, // 5^-236
+  {LIT64(0xa2cb1717b52481ed), LIT64(0x54768c4b0c64ca6e)}, // 5^-235
+  {LIT64(0xcb7ddcdda26da268), LIT64(0xa9942f5dcf7dfd09)}, // 5^-234
+  {LIT64(0xfe5d54150b090b02), LIT64(0xd3f93b35435d7c4c)}, // 5^-233
+  {LIT64(0x9efa548d26e5a6e1), LIT64(0xc47bc5014a1a6daf)}, // 5^-232
+  {LIT64(0xc6b8e9b0709f109a), LIT64(0x359ab6419ca1091b)}, // 5^-231
+  {LIT64(0xf867241c8cc6d4c0), LIT64(0xc30163d203c94b62)}, // 5^-230
+  {LIT64(0x9b407691d7fc44f8), LIT64(0x79e0de63425dcf1d)}, // 5^-229
+  {LIT64(0xc21094364dfb5636), LIT64(0x985915fc12f542e4)}, // 5^-228
+  {LIT64(0xf294b943e17a2bc4), LIT64(0x3e6f5b7b17b2939d)}, // 5^-227
+  {LIT64(0x979cf3ca6cec5b5a), LIT64(0xa705992ceecf9c42)}, // 5^-226
+  {LIT64(0xbd8430bd08277231), LIT64(0x50c6ff782a838353)}, // 5^-225
+  {LIT64(0xece53cec4a314ebd), LIT64(0xa4f8bf5635246428)}, // 5^-224
+  {LIT64(0x940f4613ae5ed136), LIT64(0x871b7795e136be99)}, // 5^-223
+  {LIT64(0xb913179899f68584), LIT64(0x28e2557b59846e3f)}, // 5^-222
+  {LIT64(0xe757dd7ec07426e5), LIT64(0x331aeada2fe589cf)}, // 5^-221
+  {LIT64(0x9096ea6f3848984f), LIT64(0x3ff0d2c85def7621)}, // 5^-220
+  {LIT64(0xb4bca50b065abe63), LIT64(0x0fed077a756b53a9)}, // 5^-219
+  {LIT64(0xe1ebce4dc7f16dfb), LIT64(0xd3e8495912c62894)}, // 5^-218
+  {LIT64(0x8d3360f09cf6e4bd), LIT64(0x64712dd7abbbd95c)}, // 5^-217
+  {LIT64(0xb080392cc4349dec), LIT64(0xbd8d794d96aacfb3)}, // 5^-216
+  {LIT64(0xdca04777f541c567), LIT64(0xecf0d7a0fc5583a0)}, // 5^-215
+  {LIT64(0x89e42caaf9491b60), LIT64(0xf41686c49db57244)}, // 5^-214
+  {LIT64(0xac5d37d5b79b6239), LIT64(0x311c2875c522ced5)}, // 5^-213
+  {LIT64(0xd77485cb25823ac7), LIT64(0x7d633293366b828b)}, // 5^-212
+  {LIT64(0x86a8d39ef77164bc), LIT64(0xae5dff9c02033197)}, // 5^-211
+  {LIT64(0xa8530886b54dbdeb), LIT64(0xd9f57f830283fdfc)}, // 5^-210
+  {LIT64(0xd267caa862a12d66), LIT64(0xd072df63c324fd7b)}, // 5^-209
+  {LIT64(0x8380dea93da4bc60), LIT64(0x4247cb9e59f71e6d)}, // 5^-208
+  {LIT64(0xa46116538d0deb78), LIT64(0x52d9be85f074e608)}, // 5^-207
+  {LIT64(0xcd795be870516656), LIT64(0x67902e276c921f8b)}, // 5^-206
+  {LIT64(0x806bd9714632dff6), LIT64(0x00ba1cd8a3db53b6)}, // 5^-205
+  {LIT64(0xa086cfcd97bf97f3), LIT64(0x80e8a40eccd228a4)}, // 5^-204
+  {LIT64(0xc8a883c0fdaf7df0), LIT64(0x6122cd128006b2cd)}, // 5^-203
+  {LIT64(0xfad2a4b13d1b5d6c), LIT64(0x796b805720085f81)}, // 5^-202
+  {LIT64(0x9cc3a6eec6311a63), LIT64(0xcbe3303674053bb0)}, // 5^-201
+  {LIT64(0xc3f490aa77bd60fc), LIT64(0xbedbfc4411068a9c)}, // 5^-200
+  {LIT64(0xf4f1b4d515acb93b), LIT64(0xee92fb5515482d44)}, // 5^-199
+  {LIT64(0x991711052d8bf3c5), LIT64(0x751bdd152d4d1c4a)}, // 5^-198
+  {LIT64(0xbf5cd54678eef0b6), LIT64(0xd262d45a78a0635d)}, // 5^-197
+  {LIT64(0xef340a98172aace4), LIT64(0x86fb897116c87c34)}, // 5^-196
+  {LIT64(0x9580869f0e7aac0e), LIT64(0xd45d35e6ae3d4da0)}, // 5^-195
+  {LIT64(0xbae0a846d2195712), LIT64(0x8974836059cca109)}, // 5^-194
+  {LIT64(0xe998d258869facd7), LIT64(0x2bd1a438703fc94b)}, // 5^-193
+  {LIT64(0x91ff83775423cc06), LIT64(0x7b6306a34627ddcf)}, // 5^-192
+  {LIT64(0xb67f6455292cbf08), LIT64(0x1a3bc84c17b1d542)}, // 5^-191
+  {LIT64(0xe41f3d6a7377eeca), LIT64(0x20caba5f1d9e4a93)}, // 5^-190
+  {LIT64(0x8e938662882af53e), LIT64(0x547eb47b7282ee9c)}, // 5^-189
+  {LIT64(0xb23867fb2a35b28d), LIT64(0xe99e619a4f23aa43)}, // 5^-188
+  {LIT64(0xdec681f9f4c31f31), LIT64(0x6405fa00e2ec94d4)}, // 5^-187
+  {LIT64(0x8b3c113c38f9f37e), LIT64(0xde83bc408dd3dd04)}, // 5^-186
+  {LIT64(0xae0b158b4738705e), LIT64(0x9624ab50b148d445)}, // 5^-185
+  {LIT64(0xd98ddaee19068c76), LIT64(0x3badd624dd9b0957)}, // 5^-184
+  {LIT64(0x87f8a8d4cfa417c9), LIT64(0xe54ca5d70a80e5d6)}, // 5^-183
+  {LIT64(0xa9f6d30a038d1dbc), LIT64(0x5e9fcf4ccd211f4c)}, // 5^-182
+  {LIT64(0xd47487cc8470652b), LIT64(0x7647c3200069671f)}, // 5^-181
+  {LIT64(0x84c8d4dfd2c63f3b), LIT64(0x29ecd9f40041e073)}, // 5^-180
+  {LIT64(0xa5fb0a17c777cf09), LIT64(0xf468107100525890)}, // 5^-179
+  {LIT64(0xcf79cc9db955c2cc), LIT64(0x7182148d4066eeb4)}, // 5^-178
+  {LIT64(0x81ac1fe293d599bf), LIT64(0xc6f14cd848405530)}, // 5^-177
+  {LIT64(0xa21727db38cb002f), LIT64(0xb8ada00e5a506a7c)}, // 5^-176
+  {LIT64(0xca9cf1d206fdc03b), LIT64(0xa6d90811f0e4851c)}, // 5^-175
+  {LIT64(0xfd442e4688bd304a), LIT64(0x908f4a166d1da663)}, // 5^-174
+  {LIT64(0x9e4a9cec15763e2e), LIT64(0x9a598e4e043287fe)}, // 5^-173
+  {LIT64(0xc5dd44271ad3cdba), LIT64(0x40eff1e1853f29fd)}, // 5^-172
+  {LIT64(0xf7549530e188c128), LIT64(0xd12bee59e68ef47c)}, // 5^-171
+  {LIT64(0x9a94dd3e8cf578b9), LIT64(0x82bb74f8301958ce)}, // 5^-170
+  {LIT64(0xc13a148e3032d6e7), LIT64(0xe36a52363c1faf01)}, // 5^-169
+  {LIT64(0xf18899b1bc3f8ca1), LIT64(0xdc44e6c3cb279ac1)}, // 5^-168
+  {LIT64(0x96f5600f15a7b7e5), LIT64(0x29ab103a5ef8c0b9)}, // 5^-167
+  {LIT64(0xbcb2b812db11a5de), LIT64(0x7415d448f6b6f0e7)}, // 5^-166
+  {LIT64(0xebdf661791d60f56), LIT64(0x111b495b3464ad21)}, // 5^-165
+  {LIT64(0x936b9fcebb25c995), LIT64(0xcab10dd900beec34)}, // 5^-164
+  {LIT64(0xb84687c269ef3bfb), LIT64(0x3d5d514f40eea742)}, // 5^-163
+  {LIT64(0xe65829b3046b0afa), LIT64(0x0cb4a5a3112a5112)}, // 5^-162
+  {LIT64(0x8ff71a0fe2c2e6dc), LIT64(0x47f0e785eaba72ab)}, // 5^-161
+  {LIT64(0xb3f4e093db73a093), LIT64(0x59ed216765690f56)}, // 5^-160
+  {LIT64(0xe0f218b8d25088b8), LIT64(0x306869c13ec3532c)}, // 5^-159
+  {LIT64(0x8c974f7383725573), LIT64(0x1e414218c73a13fb)}, // 5^-158
+  {LIT64(0xafbd2350644eeacf), LIT64(0xe5d1929ef90898fa)}, // 5^-157
+  {LIT64(0xdbac6c247d62a583), LIT64(0xdf45f746b74abf39)}, // 5^-156
+  {LIT64(0x894bc396ce5da772), LIT64(0x6b8bba8c328eb783)}, // 5^-155
+  {LIT64(0xab9eb47c81f5114f), LIT64(0x066ea92f3f326564)}, // 5^-154
+  {LIT64(0xd686619ba27255a2), LIT64(0xc80a537b0efefebd)}, // 5^-153
+  {LIT64(0x8613fd0145877585), LIT64(0xbd06742ce95f5f36)}, // 5^-152
+  {LIT64(0xa798fc4196e952e7), LIT64(0x2c48113823b73704)}, // 5^-151
+  {LIT64(0xd17f3b51fca3a7a0), LIT64(0xf75a15862ca504c5)}, // 5^-150
+  {LIT64(0x82ef85133de648c4), LIT64(0x9a984d73dbe722fb)}, // 5^-149
+  {LIT64(0xa3ab66580d5fdaf5), LIT64(0xc13e60d0d2e0ebba)}, // 5^-148
+  {LIT64(0xcc963fee10b7d1b3), LIT64(0x318df905079926a8)}, // 5^-147
+  {LIT64(0xffbbcfe994e5c61f), LIT64(0xfdf17746497f7052)}, // 5^-146
+  {LIT64(0x9fd561f1fd0f9bd3), LIT64(0xfeb6ea8bedefa633)}, // 5^-145
+  {LIT64(0xc7caba6e7c5382c8), LIT64(0xfe64a52ee96b8fc0)}, // 5^-144
+  {LIT64(0xf9bd690a1b68637b), LIT64(0x3dfdce7aa3c673b0)}, // 5^-143
+  {LIT64(0x9c1661a651213e2d), LIT64(0x06bea10ca65c084e)}, // 5^-142
+  {LIT64(0xc31bfa0fe5698db8), LIT64(0x486e494fcff30a62)}, // 5^-141
+  {LIT64(0xf3e2f893dec3f126), LIT64(0x5a89dba3c3efccfa)}, // 5^-140
+  {LIT64(0x986ddb5c6b3a76b7), LIT64(0xf89629465a75e01c)}, // 5^-139
+  {LIT64(0xbe89523386091465), LIT64(0xf6bbb397f1135823)}, // 5^-138
+  {LIT64(0xee2ba6c0678b597f), LIT64(0x746aa07ded582e2c)}, // 5^-137
+  {LIT64(0x94db483840b717ef), LIT64(0xa8c2a44eb4571cdc)}, // 5^-136
+  {LIT64(0xba121a4650e4ddeb), LIT64(0x92f34d62616ce413)}, // 5^-135
+  {LIT64(0xe896a0d7e51e1566), LIT64(0x77b020baf9c81d17)}, // 5^-134
+  {LIT64(0x915e2486ef32cd60), LIT64(0x0ace1474dc1d122e)}, // 5^-133
+  {LIT64(0xb5b5ada8aaff80b8), LIT64(0x0d819992132456ba)}, // 5^-132
+  {LIT64(0xe3231912d5bf60e6), LIT64(0x10e1fff697ed6c69)}, // 5^-131
+  {LIT64(0x8df5efabc5979c8f), LIT64(0xca8d3ffa1ef463c1)}, // 5^-130
+  {LIT64(0xb1736b96b6fd83b3), LIT64(0xbd308ff8a6b17cb2)}, // 5^-129
+  {LIT64(0xddd0467c64bce4a0), LIT64(0xac7cb3f6d05ddbde)}, // 5^-128
+  {LIT64(0x8aa22c0dbef60ee4), LIT64(0x6bcdf07a423aa96b)}, // 5^-127
+  {LIT64(0xad4ab7112eb3929d), LIT64(0x86c16c98d2c953c6)}, // 5^-126
+  {LIT64(0xd89d64d57a607744), LIT64(0xe871c7bf077ba8b7)}, // 5^-125
+  {LIT64(0x87625f056c7c4a8b), LIT64(0x11471cd764ad4972)}, // 5^-124
+  {LIT64(0xa93af6c6c79b5d2d), LIT64(0xd598e40d3dd89bcf)}, // 5^-123
+  {LIT64(0xd389b47879823479), LIT64(0x4aff1d108d4ec2c3)}, // 5^-122
+  {LIT64(0x843610cb4bf160cb), LIT64(0xcedf722a585139ba)}, // 5^-121
+  {LIT64(0xa54394fe1eedb8fe), LIT64(0xc2974eb4ee658828)}, // 5^-120
+  {LIT64(0xce947a3da6a9273e), LIT64(0x733d226229feea32)}, // 5^-119
+  {LIT64(0x811ccc668829b887), LIT64(0x0806357d5a3f525f)}, // 5^-118
+  {LIT64(0xa163ff802a3426a8), LIT64(0xca07c2dcb0cf26f7)}, // 5^-117
+  {LIT64(0xc9bcff6034c13052), LIT64(0xfc89b393dd02f0b5)}, // 5^-116
+  {LIT64(0xfc2c3f3841f17c67), LIT64(0xbbac2078d443ace2)}, // 5^-115
+  {LIT64(0x9d9ba7832936edc0), LIT64(0xd54b944b84aa4c0d)}, // 5^-114
+  {LIT64(0xc5029163f384a931), LIT64(0x0a9e795e65d4df11)}, // 5^-113
+  {LIT64(0xf64335bcf065d37d), LIT64(0x4d4617b5ff4a16d5)}, // 5^-112
+  {LIT64(0x99ea0196163fa42e), LIT64(0x504bced1bf8e4e45)}, // 5^-111
+  {LIT64(0xc06481fb9bcf8d39), LIT64(0xe45ec2862f71e1d6)}, // 5^-110
+  {LIT64(0xf07da27a82c37088), LIT64(0x5d767327bb4e5a4c)}, // 5^-109
+  {LIT64(0x964e858c91ba2655), LIT64(0x3a6a07f8d510f86f)}, // 5^-108
+  {LIT64(0xbbe226efb628afea), LIT64(0x890489f70a55368b)}, // 5^-107
+  {LIT64(0xeadab0aba3b2dbe5), LIT64(0x2b45ac74ccea842e)}, // 5^-106
+  {LIT64(0x92c8ae6b464fc96f), LIT64(0x3b0b8bc90012929d)}, // 5^-105
+  {LIT64(0xb77ada0617e3bbcb), LIT64(0x09ce6ebb40173744)}, // 5^-104
+  {LIT64(0xe55990879ddcaabd), LIT64(0xcc420a6a101d0515)}, // 5^-103
+  {LIT64(0x8f57fa54c2a9eab6), LIT64(0x9fa946824a12232d)}, // 5^-102
+  {LIT64(0xb32df8e9f3546564), LIT64(0x47939822dc96abf9)}, // 5^-101
+  {LIT64(0xdff9772470297ebd), LIT64(0x59787e2b93bc56f7)}, // 5^-100
+  {LIT64(0x8bfbea76c619ef36), LIT64(0x57eb4edb3c55b65a)}, // 5^-99
+  {LIT64(0xaefae51477a06b03), LIT64(0xede622920b6b23f1)}, // 5^-98
+  {LIT64(0xdab99e59958885c4), LIT64(0xe95fab368e45eced)}, // 5^-97
+  {LIT64(0x88b402f7fd75539b), LIT64(0x11dbcb0218ebb414)}, // 5^-96
+  {LIT64(0xaae103b5fcd2a881), LIT64(0xd652bdc29f26a119)}, // 5^-95
+  {LIT64(0xd59944a37c0752a2), LIT64(0x4be76d3346f0495f)}, // 5^-94
+  {LIT64(0x857fcae62d8493a5), LIT64(0x6f70a4400c562ddb)}, // 5^-93
+  {LIT64(0xa6dfbd9fb8e5b88e), LIT64(0xcb4ccd500f6bb952)}, // 5^-92
+  {LIT64(0xd097ad07a71f26b2), LIT64(0x7e2000a41346a7a7)}, // 5^-91
+  {LIT64(0x825ecc24c873782f), LIT64(0x8ed400668c0c28c8)}, // 5^-90
+  {LIT64(0xa2f67f2dfa90563b), LIT64(0x728900802f0f32fa)}, // 5^-89
+  {LIT64(0xcbb41ef979346bca), LIT64(0x4f2b40a03ad2ffb9)}, // 5^-88
+  {LIT64(0xfea126b7d78186bc), LIT64(0xe2f610c84987bfa8)}, // 5^-87
+  {LIT64(0x9f24b832e6b0f436), LIT64(0x0dd9ca7d2df4d7c9)}, // 5^-86
+  {LIT64(0xc6ede63fa05d3143), LIT64(0x91503d1c79720dbb)}, // 5^-85
+  {LIT64(0xf8a95fcf88747d94), LIT64(0x75a44c6397ce912a)}, // 5^-84
+  {LIT64(0x9b69dbe1b548ce7c), LIT64(0xc986afbe3ee11aba)}, // 5^-83
+  {LIT64(0xc24452da229b021b), LIT64(0xfbe85badce996168)}, // 5^-82
+  {LIT64(0xf2d56790ab41c2a2), LIT64(0xfae27299423fb9c3)}, // 5^-81
+  {LIT64(0x97c560ba6b0919a5), LIT64(0xdccd879fc967d41a)}, // 5^-80
+  {LIT64(0xbdb6b8e905cb600f), LIT64(0x5400e987bbc1c920)}, // 5^-79
+  {LIT64(0xed246723473e3813), LIT64(0x290123e9aab23b68)}, // 5^-78
+  {LIT64(0x9436c0760c86e30b), LIT64(0xf9a0b6720aaf6521)}, // 5^-77
+  {LIT64(0xb94470938fa89bce), LIT64(0xf808e40e8d5b3e69)}, // 5^-76
+  {LIT64(0xe7958cb87392c2c2), LIT64(0xb60b1d1230b20e04)}, // 5^-75
+  {LIT64(0x90bd77f3483bb9b9), LIT64(0xb1c6f22b5e6f48c2)}, // 5^-74
+  {LIT64(0xb4ecd5f01a4aa828), LIT64(0x1e38aeb6360b1af3)}, // 5^-73
+  {LIT64(0xe2280b6c20dd5232), LIT64(0x25c6da63c38de1b0)}, // 5^-72
+  {LIT64(0x8d590723948a535f), LIT64(0x579c487e5a38ad0e)}, // 5^-71
+  {LIT64(0xb0af48ec79ace837), LIT64(0x2d835a9df0c6d851)}, // 5^-70
+  {LIT64(0xdcdb1b2798182244), LIT64(0xf8e431456cf88e65)}, // 5^-69
+  {LIT64(0x8a08f0f8bf0f156b), LIT64(0x1b8e9ecb641b58ff)}, // 5^-68
+  {LIT64(0xac8b2d36eed2dac5), LIT64(0xe272467e3d222f3f)}, // 5^-67
+  {LIT64(0xd7adf884aa879177), LIT64(0x5b0ed81dcc6abb0f)}, // 5^-66
+  {LIT64(0x86ccbb52ea94baea), LIT64(0x98e947129fc2b4e9)}, // 5^-65
+  {LIT64(0xa87fea27a539e9a5), LIT64(0x3f2398d747b36224)}, // 5^-64
+  {LIT64(0xd29fe4b18e88640e), LIT64(0x8eec7f0d19a03aad)}, // 5^-63
+  {LIT64(0x83a3eeeef9153e89), LIT64(0x1953cf68300424ac)}, // 5^-62
+  {LIT64(0xa48ceaaab75a8e2b), LIT64(0x5fa8c3423c052dd7)}, // 5^-61
+  {LIT64(0xcdb02555653131b6), LIT64(0x3792f412cb06794d)}, // 5^-60
+  {LIT64(0x808e17555f3ebf11), LIT64(0xe2bbd88bbee40bd0)}, // 5^-59
+  {LIT64(0xa0b19d2ab70e6ed6), LIT64(0x5b6aceaeae9d0ec4)}, // 5^-58
+  {LIT64(0xc8de047564d20a8b), LIT64(0xf245825a5a445275)}, // 5^-57
+  {LIT64(0xfb158592be068d2e), LIT64(0xeed6e2f0f0d56712)}, // 5^-56
+  {LIT64(0x9ced737bb6c4183d), LIT64(0x55464dd69685606b)}, // 5^-55
+  {LIT64(0xc428d05aa4751e4c), LIT64(0xaa97e14c3c26b886)}, // 5^-54
+  {LIT64(0xf53304714d9265df), LIT64(0xd53dd99f4b3066a8)}, // 5^-53
+  {LIT64(0x993fe2c6d07b7fab), LIT64(0xe546a8038efe4029)}, // 5^-52
+  {LIT64(0xbf8fdb78849a5f96), LIT64(0xde98520472bdd033)}, // 5^-51
+  {LIT64(0xef73d256a5c0f77c), LIT64(0x963e66858f6d4440)}, // 5^-50
+  {LIT64(0x95a8637627989aad), LIT64(0xdde7001379a44aa8)}, // 5^-49
+  {LIT64(0xbb127c53b17ec159), LIT64(0x5560c018580d5d52)}, // 5^-48
+  {LIT64(0xe9d71b689dde71af), LIT64(0xaab8f01e6e10b4a6)}, // 5^-47
+  {LIT64(0x9226712162ab070d), LIT64(0xcab3961304ca70e8)}, // 5^-46
+  {LIT64(0xb6b00d69bb55c8d1), LIT64(0x3d607b97c5fd0d22)}, // 5^-45
+  {LIT64(0xe45c10c42a2b3b05), LIT64(0x8cb89a7db77c506a)}, // 5^-44
+  {LIT64(0x8eb98a7a9a5b04e3), LIT64(0x77f3608e92adb242)}, // 5^-43
+  {LIT64(0xb267ed1940f1c61c), LIT64(0x55f038b237591ed3)}, // 5^-42
+  {LIT64(0xdf01e85f912e37a3), LIT64(0x6b6c46dec52f6688)}, // 5^-41
+  {LIT64(0x8b61313bbabce2c6), LIT64(0x2323ac4b3b3da015)}, // 5^-40
+  {LIT64(0xae397d8aa96c1b77), LIT64(0xabec975e0a0d081a)}, // 5^-39
+  {LIT64(0xd9c7dced53c72255), LIT64(0x96e7bd358c904a21)}, // 5^-38
+  {LIT64(0x881cea14545c7575), LIT64(0x7e50d64177da2e54)}, // 5^-37
+  {LIT64(0xaa242499697392d2), LIT64(0xdde50bd1d5d0b9e9)}, // 5^-36
+  {LIT64(0xd4ad2dbfc3d07787), LIT64(0x955e4ec64b44e864)}, // 5^-35
+  {LIT64(0x84ec3c97da624ab4), LIT64(0xbd5af13bef0b113e)}, // 5^-34
+  {LIT64(0xa6274bbdd0fadd61), LIT64(0xecb1ad8aeacdd58e)}, // 5^-33
+  {LIT64(0xcfb11ead453994ba), LIT64(0x67de18eda5814af2)}, // 5^-32
+  {LIT64(0x81ceb32c4b43fcf4), LIT64(0x80eacf948770ced7)}, // 5^-31
+  {LIT64(0xa2425ff75e14fc31), LIT64(0xa1258379a94d028d)}, // 5^-30
+  {LIT64(0xcad2f7f5359a3b3e), LIT64(0x096ee45813a04330)}, // 5^-29
+  {LIT64(0xfd87b5f28300ca0d), LIT64(0x8bca9d6e188853fc)}, // 5^-28
+  {LIT64(0x9e74d1b791e07e48), LIT64(0x775ea264cf55347d)}, // 5^-27
+  {LIT64(0xc612062576589dda), LIT64(0x95364afe032a819d)}, // 5^-26
+  {LIT64(0xf79687aed3eec551), LIT64(0x3a83ddbd83f52204)}, // 5^-25
+  {LIT64(0x9abe14cd44753b52), LIT64(0xc4926a9672793542)}, // 5^-24
+  {LIT64(0xc16d9a0095928a27), LIT64(0x75b7053c0f178293)}, // 5^-23
+  {LIT64(0xf1c90080baf72cb1), LIT64(0x5324c68b12dd6338)}, // 5^-22
+  {LIT64(0x971da05074da7bee), LIT64(0xd3f6fc16ebca5e03)}, // 5^-21
+  {LIT64(0xbce5086492111aea), LIT64(0x88f4bb1ca6bcf584)}, // 5^-20
+  {LIT64(0xec1e4a7db69561a5), LIT64(0x2b31e9e3d06c32e5)}, // 5^-19
+  {LIT64(0x9392ee8e921d5d07), LIT64(0x3aff322e62439fcf)}, // 5^-18
+  {LIT64(0xb877aa3236a4b449), LIT64(0x09befeb9fad487c2)}, // 5^-17
+  {LIT64(0xe69594bec44de15b), LIT64(0x4c2ebe687989a9b3)}, // 5^-16
+  {LIT64(0x901d7cf73ab0acd9), LIT64(0x0f9d37014bf60a10)}, // 5^-15
+  {LIT64(0xb424dc35095cd80f), LIT64(0x538484c19ef38c94)}, // 5^-14
+  {LIT64(0xe12e13424bb40e13), LIT64(0x2865a5f206b06fb9)}, // 5^-13
+  {LIT64(0x8cbccc096f5088cb), LIT64(0xf93f87b7442e45d3)}, // 5^-12
+  {LIT64(0xafebff0bcb24aafe), LIT64(0xf78f69a51539d748)}, // 5^-11
+  {LIT64(0xdbe6fecebdedd5be), LIT64(0xb573440e5a884d1b)}, // 5^-10
+  {LIT64(0x89705f4136b4a597), LIT64(0x31680a88f8953030)}, // 5^-9
+  {LIT64(0xabcc77118461cefc), LIT64(0xfdc20d2b36ba7c3d)}, // 5^-8
+  {LIT64(0xd6bf94d5e57a42bc), LIT64(0x3d32907604691b4c)}, // 5^-7
+  {LIT64(0x8637bd05af6c69b5), LIT64(0xa63f9a49c2c1b10f)}, // 5^-6
+  {LIT64(0xa7c5ac471b478423), LIT64(0x0fcf80dc33721d53)}, // 5^-5
+  {LIT64(0xd1b71758e219652b), LIT64(0xd3c36113404ea4a8)}, // 5^-4
+  {LIT64(0x83126e978d4fdf3b), LIT64(0x645a1cac083126e9)}, // 5^-3
+  {LIT64(0xa3d70a3d70a3d70a), LIT64(0x3d70a3d70a3d70a3)}, // 5^-2
+  {LIT64(0xcccccccccccccccc), LIT64(0xcccccccccccccccc)}, // 5^-1
+  {LIT64(0x8000000000000000), LIT64(0x0000000000000000)}, // 5^0
+  {LIT64(0xa000000000000000), LIT64(0x0000000000000000)}, // 5^1
+  {LIT64(0xc800000000000000), LIT64(0x0000000000000000)}, // 5^2
+  {LIT64(0xfa00000000000000), LIT64(0x0000000000000000)}, // 5^3
+  {LIT64(0x9c40000000000000), LIT64(0x0000000000000000)}, // 5^4
+  {LIT64(0xc350000000000000), LIT64(0x0000000000000000)}, // 5^5
+  {LIT64(0xf424000000000000), LIT64(0x0000000000000000)}, // 5^6
+  {LIT64(0x9896800000000000), LIT64(0x0000000000000000)}, // 5^7
+  {LIT64(0xbebc200000000000), LIT64(0x0000000000000000)}, // 5^8
+  {LIT64(0xee6b280000000000), LIT64(0x0000000000000000)}, // 5^9
+  {LIT64(0x9502f90000000000), LIT64(0x0000000000000000)}, // 5^10
+  {LIT64(0xba43b74000000000), LIT64(0x0000000000000000)}, // 5^11
+  {LIT64(0xe8d4a51000000000), LIT64(0x0000000000000000)}, // 5^12
+  {LIT64(0x9184e72a00000000), LIT64(0x0000000000000000)}, // 5^13
+  {LIT64(0xb5e620f480000000), LIT64(0x0000000000000000)}, // 5^14
+  {LIT64(0xe35fa931a0000000), LIT64(0x0000000000000000)}, // 5^15
+  {LIT64(0x8e1bc9bf04000000), LIT64(0x0000000000000000)}, // 5^16
+  {LIT64(0xb1a2bc2ec5000000), LIT64(0x0000000000000000)}, // 5^17
+  {LIT64(0xde0b6b3a76400000), LIT64(0x0000000000000000)}, // 5^18
+  {LIT64(0x8ac7230489e80000), LIT64(0x0000000000000000)}, // 5^19
+  {LIT64(0xad78ebc5ac620000), LIT64(0x0000000000000000)}, // 5^20
+  {LIT64(0xd8d726b7177a8000), LIT64(0x0000000000000000)}, // 5^21
+  {LIT64(0x878678326eac9000), LIT64(0x0000000000000000)}, // 5^22
+  {LIT64(0xa968163f0a57b400), LIT64(0x0000000000000000)}, // 5^23
+  {LIT64(0xd3c21bcecceda100), LIT64(0x0000000000000000)}, // 5^24
+  {LIT64(0x84595161401484a0), LIT64(0x0000000000000000)}, // 5^25
+  {LIT64(0xa56fa5b99019a5c8), LIT64(0x0000000000000000)}, // 5^26
+  {LIT64(0xcecb8f27f4200f3a), LIT64(0x0000000000000000)}, // 5^27
+  {LIT64(0x813f3978f8940984), LIT64(0x4000000000000000)}, // 5^28
+  {LIT64(0xa18f07d736b90be5), LIT64(0x5000000000000000)}, // 5^29
+  {LIT64(0xc9f2c9cd04674ede), LIT64(0xa400000000000000)}, // 5^30
+  {LIT64(0xfc6f7c4045812296), LIT64(0x4d00000000000000)}, // 5^31
+  {LIT64(0x9dc5ada82b70b59d), LIT64(0xf020000000000000)}, // 5^32
+  {LIT64(0xc5371912364ce305), LIT64(0x6c28000000000000)}, // 5^33
+  {LIT64(0xf684df56c3e01bc6), LIT64(0xc732000000000000)}, // 5^34
+  {LIT64(0x9a130b963a6c115c), LIT64(0x3c7f400000000000)}, // 5^35
+  {LIT64(0xc097ce7bc90715b3), LIT64(0x4b9f100000000000)}, // 5^36
+  {LIT64(0xf0bdc21abb48db20), LIT64(0x1e86d40000000000)}, // 5^37
+  {LIT64(0x96769950b50d88f4), LIT64(0x1314448000000000)}, // 5^38
+  {LIT64(0xbc143fa4e250eb31), LIT64(0x17d955a000000000)}, // 5^39
+  {LIT64(0xeb194f8e1ae525fd), LIT64(0x5dcfab0800000000)}, // 5^40
+  {LIT64(0x92efd1b8d0cf37be), LIT64(0x5aa1cae500000000)}, // 5^41
+  {LIT64(0xb7abc627050305ad), LIT64(0xf14a3d9e40000000)}, // 5^42
+  {LIT64(0xe596b7b0c643c719), LIT64(0x6d9ccd05d0000000)}, // 5^43
+  {LIT64(0x8f7e32ce7bea5c6f), LIT64(0xe4820023a2000000)}, // 5^44
+  {LIT64(0xb35dbf821ae4f38b), LIT64(0xdda2802c8a800000)}, // 5^45
+  {LIT64(0xe0352f62a19e306e), LIT64(0xd50b2037ad200000)}, // 5^46
+  {LIT64(0x8c213d9da502de45), LIT64(0x4526f422cc340000)}, // 5^47
+  {LIT64(0xaf298d050e4395d6), LIT64(0x9670b12b7f410000)}, // 5^48
+  {LIT64(0xdaf3f04651d47b4c), LIT64(0x3c0cdd765f114000)}, // 5^49
+  {LIT64(0x88d8762bf324cd0f), LIT64(0xa5880a69fb6ac800)}, // 5^50
+  {LIT64(0xab0e93b6efee0053), LIT64(0x8eea0d047a457a00)}, // 5^51
+  {LIT64(0xd5d238a4abe98068), LIT64(0x72a4904598d6d880)}, // 5^52
+  {LIT64(0x85a36366eb71f041), LIT64(0x47a6da2b7f864750)}, // 5^53
+  {LIT64(0xa70c3c40a64e6c51), LIT64(0x999090b65f67d924)}, // 5^54
+  {LIT64(0xd0cf4b50cfe20765), LIT64(0xfff4b4e3f741cf6d)}, // 5^55
+  {LIT64(0x82818f1281ed449f), LIT64(0xbff8f10e7a8921a4)}, // 5^56
+  {LIT64(0xa321f2d7226895c7), LIT64(0xaff72d52192b6a0d)}, // 5^57
+  {LIT64(0xcbea6f8ceb02bb39), LIT64(0x9bf4f8a69f764490)}, // 5^58
+  {LIT64(0xfee50b7025c36a08), LIT64(0x02f236d04753d5b4)}, // 5^59
+  {LIT64(0x9f4f2726179a2245), LIT64(0x01d762422c946590)}, // 5^60
+  {LIT64(0xc722f0ef9d80aad6), LIT64(0x424d3ad2b7b97ef5)}, // 5^61
+  {LIT64(0xf8ebad2b84e0d58b), LIT64(0xd2e0898765a7deb2)}, // 5^62
+  {LIT64(0x9b934c3b330c8577), LIT64(0x63cc55f49f88eb2f)}, // 5^63
+  {LIT64(0xc2781f49ffcfa6d5), LIT64(0x3cbf6b71c76b25fb)}, // 5^64
+  {LIT64(0xf316271c7fc3908a), LIT64(0x8bef464e3945ef7a)}, // 5^65
+  {LIT64(0x97edd871cfda3a56), LIT64(0x97758bf0e3cbb5ac)}, // 5^66
+  {LIT64(0xbde94e8e43d0c8ec), LIT64(0x3d52eeed1cbea317)}, // 5^67
+  {LIT64(0xed63a231d4c4fb27), LIT64(0x4ca7aaa863ee4bdd)}, // 5^68
+  {LIT64(0x945e455f24fb1cf8), LIT64(0x8fe8caa93e74ef6a)}, // 5^69
+  {LIT64(0xb975d6b6ee39e436), LIT64(0xb3e2fd538e122b44)}, // 5^70
+  {LIT64(0xe7d34c64a9c85d44), LIT64(0x60dbbca87196b616)}, // 5^71
+  {LIT64(0x90e40fbeea1d3a4a), LIT64(0xbc8955e946fe31cd)}, // 5^72
+  {LIT64(0xb51d13aea4a488dd), LIT64(0x6babab6398bdbe41)}, // 5^73
+  {LIT64(0xe264589a4dcdab14), LIT64(0xc696963c7eed2dd1)}, // 5^74
+  {LIT64(0x8d7eb76070a08aec), LIT64(0xfc1e1de5cf543ca2)}, // 5^75
+  {LIT64(0xb0de65388cc8ada8), LIT64(0x3b25a55f43294bcb)}, // 5^76
+  {LIT64(0xdd15fe86affad912), LIT64(0x49ef0eb713f39ebe)}, // 5^77
+  {LIT64(0x8a2dbf142dfcc7ab), LIT64(0x6e3569326c784337)}, // 5^78
+  {LIT64(0xacb92ed9397bf996), LIT64(0x49c2c37f07965404)}, // 5^79
+  {LIT64(0xd7e77a8f87daf7fb), LIT64(0xdc33745ec97be906)}, // 5^80
+  {LIT64(0x86f0ac99b4e8dafd), LIT64(0x69a028bb3ded71a3)}, // 5^81
+  {LIT64(0xa8acd7c0222311bc), LIT64(0xc40832ea0d68ce0c)}, // 5^82
+  {LIT64(0xd2d80db02aabd62b), LIT64(0xf50a3fa490c30190)}, // 5^83
+  {LIT64(0x83c7088e1aab65db), LIT64(0x792667c6da79e0fa)}, // 5^84
+  {LIT64(0xa4b8cab1a1563f52), LIT64(0x577001b891185938)}, // 5^85
+  {LIT64(0xcde6fd5e09abcf26), LIT64(0xed4c0226b55e6f86)}, // 5^86
+  {LIT64(0x80b05e5ac60b6178), LIT64(0x544f8158315b05b4)}, // 5^87
+  {LIT64(0xa0dc75f1778e39d6), LIT64(0x696361ae3db1c721)}, // 5^88
+  {LIT64(0xc913936dd571c84c), LIT64(0x03bc3a19cd1e38e9)}, // 5^89
+  {LIT64(0xfb5878494ace3a5f), LIT64(0x04ab48a04065c723)}, // 5^90
+  {LIT64(0x9d174b2dcec0e47b), LIT64(0x62eb0d64283f9c76)}, // 5^91
+  {LIT64(0xc45d1df942711d9a), LIT64(0x3ba5d0bd324f8394)}, // 5^92
+  {LIT64(0xf5746577930d6500), LIT64(0xca8f44ec7ee36479)}, // 5^93
+  {LIT64(0x9968bf6abbe85f20), LIT64(0x7e998b13cf4e1ecb)}, // 5^94
+  {LIT64(0xbfc2ef456ae276e8), LIT64(0x9e3fedd8c321a67e)}, // 5^95
+  {LIT64(0xefb3ab16c59b14a2), LIT64(0xc5cfe94ef3ea101e)}, // 5^96
+  {LIT64(0x95d04aee3b80ece5), LIT64(0xbba1f1d158724a12)}, // 5^97
+  {LIT64(0xbb445da9ca61281f), LIT64(0x2a8a6e45ae8edc97)}, // 5^98
+  {LIT64(0xea1575143cf97226), LIT64(0xf52d09d71a3293bd)}, // 5^99
+  {LIT64(0x924d692ca61be758), LIT64(0x593c2626705f9c56)}, // 5^100
+  {LIT64(0xb6e0c377cfa2e12e), LIT64(0x6f8b2fb00c77836c)}, // 5^101
+  {LIT64(0xe498f455c38b997a), LIT64(0x0b6dfb9c0f956447)}, // 5^102
+  {LIT64(0x8edf98b59a373fec), LIT64(0x4724bd4189bd5eac)}, // 5^103
+  {LIT64(0xb2977ee300c50fe7), LIT64(0x58edec91ec2cb657)}, // 5^104
+  {LIT64(0xdf3d5e9bc0f653e1), LIT64(0x2f2967b66737e3ed)}, // 5^105
+  {LIT64(0x8b865b215899f46c), LIT64(0xbd79e0d20082ee74)}, // 5^106
+  {LIT64(0xae67f1e9aec07187), LIT64(0xecd8590680a3aa11)}, // 5^107
+  {LIT64(0xda01ee641a708de9), LIT64(0xe80e6f4820cc9495)}, // 5^108
+  {LIT64(0x884134fe908658b2), LIT64(0x3109058d147fdcdd)}, // 5^109
+  {LIT64(0xaa51823e34a7eede), LIT64(0xbd4b46f0599fd415)}, // 5^110
+  {LIT64(0xd4e5e2cdc1d1ea96), LIT64(0x6c9e18ac7007c91a)}, // 5^111
+  {LIT64(0x850fadc09923329e), LIT64(0x03e2cf6bc604ddb0)}, // 5^112
+  {LIT64(0xa6539930bf6bff45), LIT64(0x84db8346b786151c)}, // 5^113
+  {LIT64(0xcfe87f7cef46ff16), LIT64(0xe612641865679a63)}, // 5^114
+  {LIT64(0x81f14fae158c5f6e), LIT64(0x4fcb7e8f3f60c07e)}, // 5^115
+  {LIT64(0xa26da3999aef7749), LIT64(0xe3be5e330f38f09d)}, // 5^116
+  {LIT64(0xcb090c8001ab551c), LIT64(0x5cadf5bfd3072cc5)}, // 5^117
+  {LIT64(0xfdcb4fa002162a63), LIT64(0x73d9732fc7c8f7f6)}, // 5^118
+  {LIT64(0x9e9f11c4014dda7e), LIT64(0x2867e7fddcdd9afa)}, // 5^119
+  {LIT64(0xc646d63501a1511d), LIT64(0xb281e1fd541501b8)}, // 5^120
+  {LIT64(0xf7d88bc24209a565), LIT64(0x1f225a7ca91a4226)}, // 5^121
+  {LIT64(0x9ae757596946075f), LIT64(0x3375788de9b06958)}, // 5^122
+  {LIT64(0xc1a12d2fc3978937), LIT64(0x0052d6b1641c83ae)}, // 5^123
+  {LIT64(0xf209787bb47d6b84), LIT64(0xc0678c5dbd23a49a)}, // 5^124
+  {LIT64(0x9745eb4d50ce6332), LIT64(0xf840b7ba963646e0)}, // 5^125
+  {LIT64(0xbd176620a501fbff), LIT64(0xb650e5a93bc3d898)}, // 5^126
+  {LIT64(0xec5d3fa8ce427aff), LIT64(0xa3e51f138ab4cebe)}, // 5^127
+  {LIT64(0x93ba47c980e98cdf), LIT64(0xc66f336c36b10137)}, // 5^128
+  {LIT64(0xb8a8d9bbe123f017), LIT64(0xb80b0047445d4184)}, // 5^129
+  {LIT64(0xe6d3102ad96cec1d), LIT64(0xa60dc059157491e5)}, // 5^130
+  {LIT64(0x9043ea1ac7e41392), LIT64(0x87c89837ad68db2f)}, // 5^131
+  {LIT64(0xb454e4a179dd1877), LIT64(0x29babe4598c311fb)}, // 5^132
+  {LIT64(0xe16a1dc9d8545e94), LIT64(0xf4296dd6fef3d67a)}, // 5^133
+  {LIT64(0x8ce2529e2734bb1d), LIT64(0x1899e4a65f58660c)}, // 5^134
+  {LIT64(0xb01ae745b101e9e4), LIT64(0x5ec05dcff72e7f8f)}, // 5^135
+  {LIT64(0xdc21a1171d42645d), LIT64(0x76707543f4fa1f73)}, // 5^136
+  {LIT64(0x899504ae72497eba), LIT64(0x6a06494a791c53a8)}, // 5^137
+  {LIT64(0xabfa45da0edbde69), LIT64(0x0487db9d17636892)}, // 5^138
+  {LIT64(0xd6f8d7509292d603), LIT64(0x45a9d2845d3c42b6)}, // 5^139
+  {LIT64(0x865b86925b9bc5c2), LIT64(0x0b8a2392ba45a9b2)}, // 5^140
+  {LIT64(0xa7f26836f282b732), LIT64(0x8e6cac7768d7141e)}, // 5^141
+  {LIT64(0xd1ef0244af2364ff), LIT64(0x3207d795430cd926)}, // 5^142
+  {LIT64(0x8335616aed761f1f), LIT64(0x7f44e6bd49e807b8)}, // 5^143
+  {LIT64(0xa402b9c5a8d3a6e7), LIT64(0x5f16206c9c6209a6)}, // 5^144
+  {LIT64(0xcd036837130890a1), LIT64(0x36dba887c37a8c0f)}, // 5^145
+  {LIT64(0x802221226be55a64), LIT64(0xc2494954da2c9789)}, // 5^146
+  {LIT64(0xa02aa96b06deb0fd), LIT64(0xf2db9baa10b7bd6c)}, // 5^147
+  {LIT64(0xc83553c5c8965d3d), LIT64(0x6f92829494e5acc7)}, // 5^148
+  {LIT64(0xfa42a8b73abbf48c), LIT64(0xcb772339ba1f17f9)}, // 5^149
+  {LIT64(0x9c69a97284b578d7), LIT64(0xff2a760414536efb)}, // 5^150
+  {LIT64(0xc38413cf25e2d70d), LIT64(0xfef5138519684aba)}, // 5^151
+  {LIT64(0xf46518c2ef5b8cd1), LIT64(0x7eb258665fc25d69)}, // 5^152
+  {LIT64(0x98bf2f79d5993802), LIT64(0xef2f773ffbd97a61)}, // 5^153
+  {LIT64(0xbeeefb584aff8603), LIT64(0xaafb550ffacfd8fa)}, // 5^154
+  {LIT64(0xeeaaba2e5dbf6784), LIT64(0x95ba2a53f983cf38)}, // 5^155
+  {LIT64(0x952ab45cfa97a0b2), LIT64(0xdd945a747bf26183)}, // 5^156
+  {LIT64(0xba756174393d88df), LIT64(0x94f971119aeef9e4)}, // 5^157
+  {LIT64(0xe912b9d1478ceb17), LIT64(0x7a37cd5601aab85d)}, // 5^158
+  {LIT64(0x91abb422ccb812ee), LIT64(0xac62e055c10ab33a)}, // 5^159
+  {LIT64(0xb616a12b7fe617aa), LIT64(0x577b986b314d6009)}, // 5^160
+  {LIT64(0xe39c49765fdf9d94), LIT64(0xed5a7e85fda0b80b)}, // 5^161
+  {LIT64(0x8e41ade9fbebc27d), LIT64(0x14588f13be847307)}, // 5^162
+  {LIT64(0xb1d219647ae6b31c), LIT64(0x596eb2d8ae258fc8)}, // 5^163
+  {LIT64(0xde469fbd99a05fe3), LIT64(0x6fca5f8ed9aef3bb)}, // 5^164
+  {LIT64(0x8aec23d680043bee), LIT64(0x25de7bb9480d5854)}, // 5^165
+  {LIT64(0xada72ccc20054ae9), LIT64(0xaf561aa79a10ae6a)}, // 5^166
+  {LIT64(0xd910f7ff28069da4), LIT64(0x1b2ba1518094da04)}, // 5^167
+  {LIT64(0x87aa9aff79042286), LIT64(0x90fb44d2f05d0842)}, // 5^168
+  {LIT64(0xa99541bf57452b28), LIT64(0x353a1607ac744a53)}, // 5^169
+  {LIT64(0xd3fa922f2d1675f2), LIT64(0x42889b8997915ce8)}, // 5^170
+  {LIT64(0x847c9b5d7c2e09b7), LIT64(0x69956135febada11)}, // 5^171
+  {LIT64(0xa59bc234db398c25), LIT64(0x43fab9837e699095)}, // 5^172
+  {LIT64(0xcf02b2c21207ef2e), LIT64(0x94f967e45e03f4bb)}, // 5^173
+  {LIT64(0x8161afb94b44f57d), LIT64(0x1d1be0eebac278f5)}, // 5^174
+  {LIT64(0xa1ba1ba79e1632dc), LIT64(0x6462d92a69731732)}, // 5^175
+  {LIT64(0xca28a291859bbf93), LIT64(0x7d7b8f7503cfdcfe)}, // 5^176
+  {LIT64(0xfcb2cb35e702af78), LIT64(0x5cda735244c3d43e)}, // 5^177
+  {LIT64(0x9defbf01b061adab), LIT64(0x3a0888136afa64a7)}, // 5^178
+  {LIT64(0xc56baec21c7a1916), LIT64(0x088aaa1845b8fdd0)}, // 5^179
+  {LIT64(0xf6c69a72a3989f5b), LIT64(0x8aad549e57273d45)}, // 5^180
+  {LIT64(0x9a3c2087a63f6399), LIT64(0x36ac54e2f678864b)}, // 5^181
+  {LIT64(0xc0cb28a98fcf3c7f), LIT64(0x84576a1bb416a7dd)}, // 5^182
+  {LIT64(0xf0fdf2d3f3c30b9f), LIT64(0x656d44a2a11c51d5)}, // 5^183
+  {LIT64(0x969eb7c47859e743), LIT64(0x9f644ae5a4b1b325)}, // 5^184
+  {LIT64(0xbc4665b596706114), LIT64(0x873d5d9f0dde1fee)}, // 5^185
+  {LIT64(0xeb57ff22fc0c7959), LIT64(0xa90cb506d155a7ea)}, // 5^186
+  {LIT64(0x9316ff75dd87cbd8), LIT64(0x09a7f12442d588f2)}, // 5^187
+  {LIT64(0xb7dcbf5354e9bece), LIT64(0x0c11ed6d538aeb2f)}, // 5^188
+  {LIT64(0xe5d3ef282a242e81), LIT64(0x8f1668c8a86da5fa)}, // 5^189
+  {LIT64(0x8fa475791a569d10), LIT64(0xf96e017d694487bc)}, // 5^190
+  {LIT64(0xb38d92d760ec4455), LIT64(0x37c981dcc395a9ac)}, // 5^191
+  {LIT64(0xe070f78d3927556a), LIT64(0x85bbe253f47b1417)}, // 5^192
+  {LIT64(0x8c469ab843b89562), LIT64(0x93956d7478ccec8e)}, // 5^193
+  {LIT64(0xaf58416654a6babb), LIT64(0x387ac8d1970027b2)}, // 5^194
+  {LIT64(0xdb2e51bfe9d0696a), LIT64(0x06997b05fcc0319e)}, // 5^195
+  {LIT64(0x88fcf317f22241e2), LIT64(0x441fece3bdf81f03)}, // 5^196
+  {LIT64(0xab3c2fddeeaad25a), LIT64(0xd527e81cad7626c3)}, // 5^197
+  {LIT64(0xd60b3bd56a5586f1), LIT64(0x8a71e223d8d3b074)}, // 5^198
+  {LIT64(0x85c7056562757456), LIT64(0xf6872d5667844e49)}, // 5^199
+  {LIT64(0xa738c6bebb12d16c), LIT64(0xb428f8ac016561db)}, // 5^200
+  {LIT64(0xd106f86e69d785c7), LIT64(0xe13336d701beba52)}, // 5^201
+  {LIT64(0x82a45b450226b39c), LIT64(0xecc0024661173473)}, // 5^202
+  {LIT64(0xa34d721642b06084), LIT64(0x27f002d7f95d0190)}, // 5^203
+  {LIT64(0xcc20ce9bd35c78a5), LIT64(0x31ec038df7b441f4)}, // 5^204
+  {LIT64(0xff290242c83396ce), LIT64(0x7e67047175a15271)}, // 5^205
+  {LIT64(0x9f79a169bd203e41), LIT64(0x0f0062c6e984d386)}, // 5^206
+  {LIT64(0xc75809c42c684dd1), LIT64(0x52c07b78a3e60868)}, // 5^207
+  {LIT64(0xf92e0c3537826145), LIT64(0xa7709a56ccdf8a82)}, // 5^208
+  {LIT64(0x9bbcc7a142b17ccb), LIT64(0x88a66076400bb691)}, // 5^209
+  {LIT64(0xc2abf989935ddbfe), LIT64(0x6acff893d00ea435)}, // 5^210
+  {LIT64(0xf356f7ebf83552fe), LIT64(0x0583f6b8c4124d43)}, // 5^211
+  {LIT64(0x98165af37b2153de), LIT64(0xc3727a337a8b704a)}, // 5^212
+  {LIT64(0xbe1bf1b059e9a8d6), LIT64(0x744f18c0592e4c5c)}, // 5^213
+  {LIT64(0xeda2ee1c7064130c), LIT64(0x1162def06f79df73)}, // 5^214
+  {LIT64(0x9485d4d1c63e8be7), LIT64(0x8addcb5645ac2ba8)}, // 5^215
+  {LIT64(0xb9a74a0637ce2ee1), LIT64(0x6d953e2bd7173692)}, // 5^216
+  {LIT64(0xe8111c87c5c1ba99), LIT64(0xc8fa8db6ccdd0437)}, // 5^217
+  {LIT64(0x910ab1d4db9914a0), LIT64(0x1d9c9892400a22a2)}, // 5^218
+  {LIT64(0xb54d5e4a127f59c8), LIT64(0x2503beb6d00cab4b)}, // 5^219
+  {LIT64(0xe2a0b5dc971f303a), LIT64(0x2e44ae64840fd61d)}, // 5^220
+  {LIT64(0x8da471a9de737e24), LIT64(0x5ceaecfed289e5d2)}, // 5^221
+  {LIT64(0xb10d8e1456105dad), LIT64(0x7425a83e872c5f47)}, // 5^222
+  {LIT64(0xdd50f1996b947518), LIT64(0xd12f124e28f77719)}, // 5^223
+  {LIT64(0x8a5296ffe33cc92f), LIT64(0x82bd6b70d99aaa6f)}, // 5^224
+  {LIT64(0xace73cbfdc0bfb7b), LIT64(0x636cc64d1001550b)}, // 5^225
+  {LIT64(0xd8210befd30efa5a), LIT64(0x3c47f7e05401aa4e)}, // 5^226
+  {LIT64(0x8714a775e3e95c78), LIT64(0x65acfaec34810a71)}, // 5^227
+  {LIT64(0xa8d9d1535ce3b396), LIT64(0x7f1839a741a14d0d)}, // 5^228
+  {LIT64(0xd31045a8341ca07c), LIT64(0x1ede48111209a050)}, // 5^229
+  {LIT64(0x83ea2b892091e44d), LIT64(0x934aed0aab460432)}, // 5^230
+  {LIT64(0xa4e4b66b68b65d60), LIT64(0xf81da84d5617853f)}, // 5^231
+  {LIT64(0xce1de40642e3f4b9), LIT64(0x36251260ab9d668e)}, // 5^232
+  {LIT64(0x80d2ae83e9ce78f3), LIT64(0xc1d72b7c6b426019)}, // 5^233
+  {LIT64(0xa1075a24e4421730), LIT64(0xb24cf65b8612f81f)}, // 5^234
+  {LIT64(0xc94930ae1d529cfc), LIT64(0xdee033f26797b627)}, // 5^235
+  {LIT64(0xfb9b7cd9a4a7443c), LIT64(0x169840ef017da3b1)}, // 5^236
+  {LIT64(0x9d412e0806e88aa5), LIT64(0x8e1f289560ee864e)}, // 5^237
+  {LIT64(0xc491798a08a2ad4e), LIT64(0xf1a6f2bab92a27e2)}, // 5^238
+  {LIT64(0xf5b5d7ec8acb58a2), LIT64(0xae10af696774b1db)}, // 5^239
+  {LIT64(0x9991a6f3d6bf1765), LIT64(0xacca6da1e0a8ef29)}, // 5^240
+  {LIT64(0xbff610b0cc6edd3f), LIT64(0x17fd090a58d32af3)}, // 5^241
+  {LIT64(0xeff394dcff8a948e), LIT64(0xddfc4b4cef07f5b0)}, // 5^242
+  {LIT64(0x95f83d0a1fb69cd9), LIT64(0x4abdaf101564f98e)}, // 5^243
+  {LIT64(0xbb764c4ca7a4440f), LIT64(0x9d6d1ad41abe37f1)}, // 5^244
+  {LIT64(0xea53df5fd18d5513), LIT64(0x84c86189216dc5ed)}, // 5^245
+  {LIT64(0x92746b9be2f8552c), LIT64(0x32fd3cf5b4e49bb4)}, // 5^246
+  {LIT64(0xb7118682dbb66a77), LIT64(0x3fbc8c33221dc2a1)}, // 5^247
+  {LIT64(0xe4d5e82392a40515), LIT64(0x0fabaf3feaa5334a)}, // 5^248
+  {LIT64(0x8f05b1163ba6832d), LIT64(0x29cb4d87f2a7400e)}, // 5^249
+  {LIT64(0xb2c71d5bca9023f8), LIT64(0x743e20e9ef511012)}, // 5^250
+  {LIT64(0xdf78e4b2bd342cf6), LIT64(0x914da9246b255416)}, // 5^251
+  {LIT64(0x8bab8eefb6409c1a), LIT64(0x1ad089b6c2f7548e)}, // 5^252
+  {LIT64(0xae9672aba3d0c320), LIT64(0xa184ac2473b529b1)}, // 5^253
+  {LIT64(0xda3c0f568cc4f3e8), LIT64(0xc9e5d72d90a2741e)}, // 5^254
+  {LIT64(0x8865899617fb1871), LIT64(0x7e2fa67c7a658892)}, // 5^255
+  {LIT64(0xaa7eebfb9df9de8d), LIT64(0xddbb901b98feeab7)}, // 5^256
+  {LIT64(0xd51ea6fa85785631), LIT64(0x552a74227f3ea565)}, // 5^257
+  {LIT64(0x8533285c936b35de), LIT64(0xd53a88958f87275f)}, // 5^258
+  {LIT64(0xa67ff273b8460356), LIT64(0x8a892abaf368f137)}, // 5^259
+  {LIT64(0xd01fef10a657842c), LIT64(0x2d2b7569b0432d85)}, // 5^260
+  {LIT64(0x8213f56a67f6b29b), LIT64(0x9c3b29620e29fc73)}, // 5^261
+  {LIT64(0xa298f2c501f45f42), LIT64(0x8349f3ba91b47b8f)}, // 5^262
+  {LIT64(0xcb3f2f7642717713), LIT64(0x241c70a936219a73)}, // 5^263
+  {LIT64(0xfe0efb53d30dd4d7), LIT64(0xed238cd383aa0110)}, // 5^264
+  {LIT64(0x9ec95d1463e8a506), LIT64(0xf4363804324a40aa)}, // 5^265
+  {LIT64(0xc67bb4597ce2ce48), LIT64(0xb143c6053edcd0d5)}, // 5^266
+  {LIT64(0xf81aa16fdc1b81da), LIT64(0xdd94b7868e94050a)}, // 5^267
+  {LIT64(0x9b10a4e5e9913128), LIT64(0xca7cf2b4191c8326)}, // 5^268
+  {LIT64(0xc1d4ce1f63f57d72), LIT64(0xfd1c2f611f63a3f0)}, // 5^269
+  {LIT64(0xf24a01a73cf2dccf), LIT64(0xbc633b39673c8cec)}, // 5^270
+  {LIT64(0x976e41088617ca01), LIT64(0xd5be0503e085d813)}, // 5^271
+  {LIT64(0xbd49d14aa79dbc82), LIT64(0x4b2d8644d8a74e18)}, // 5^272
+  {LIT64(0xec9c459d51852ba2), LIT64(0xddf8e7d60ed1219e)}, // 5^273
+  {LIT64(0x93e1ab8252f33b45), LIT64(0xcabb90e5c942b503)}, // 5^274
+  {LIT64(0xb8da1662e7b00a17), LIT64(0x3d6a751f3b936243)}, // 5^275
+  {LIT64(0xe7109bfba19c0c9d), LIT64(0x0cc512670a783ad4)}, // 5^276
+  {LIT64(0x906a617d450187e2), LIT64(0x27fb2b80668b24c5)}, // 5^277
+  {LIT64(0xb484f9dc9641e9da), LIT64(0xb1f9f660802dedf6)}, // 5^278
+  {LIT64(0xe1a63853bbd26451), LIT64(0x5e7873f8a0396973)}, // 5^279
+  {LIT64(0x8d07e33455637eb2), LIT64(0xdb0b487b6423e1e8)}, // 5^280
+  {LIT64(0xb049dc016abc5e5f), LIT64(0x91ce1a9a3d2cda62)}, // 5^281
+  {LIT64(0xdc5c5301c56b75f7), LIT64(0x7641a140cc7810fb)}, // 5^282
+  {LIT64(0x89b9b3e11b6329ba), LIT64(0xa9e904c87fcb0a9d)}, // 5^283
+  {LIT64(0xac2820d9623bf429), LIT64(0x546345fa9fbdcd44)}, // 5^284
+  {LIT64(0xd732290fbacaf133), LIT64(0xa97c177947ad4095)}, // 5^285
+  {LIT64(0x867f59a9d4bed6c0), LIT64(0x49ed8eabcccc485d)}, // 5^286
+  {LIT64(0xa81f301449ee8c70), LIT64(0x5c68f256bfff5a74)}, // 5^287
+  {LIT64(0xd226fc195c6a2f8c), LIT64(0x73832eec6fff3111)}, // 5^288
+  {LIT64(0x83585d8fd9c25db7), LIT64(0xc831fd53c5ff7eab)}, // 5^289
+  {LIT64(0xa42e74f3d032f525), LIT64(0xba3e7ca8b77f5e55)}, // 5^290
+  {LIT64(0xcd3a1230c43fb26f), LIT64(0x28ce1bd2e55f35eb)}, // 5^291
+  {LIT64(0x80444b5e7aa7cf85), LIT64(0x7980d163cf5b81b3)}, // 5^292
+  {LIT64(0xa0555e361951c366), LIT64(0xd7e105bcc332621f)}, // 5^293
+  {LIT64(0xc86ab5c39fa63440), LIT64(0x8dd9472bf3fefaa7)}, // 5^294
+  {LIT64(0xfa856334878fc150), LIT64(0xb14f98f6f0feb951)}, // 5^295
+  {LIT64(0x9c935e00d4b9d8d2), LIT64(0x6ed1bf9a569f33d3)}, // 5^296
+  {LIT64(0xc3b8358109e84f07), LIT64(0x0a862f80ec4700c8)}, // 5^297
+  {LIT64(0xf4a642e14c6262c8), LIT64(0xcd27bb612758c0fa)}, // 5^298
+  {LIT64(0x98e7e9cccfbd7dbd), LIT64(0x8038d51cb897789c)}, // 5^299
+  {LIT64(0xbf21e44003acdd2c), LIT64(0xe0470a63e6bd56c3)}, // 5^300
+  {LIT64(0xeeea5d5004981478), LIT64(0x1858ccfce06cac74)}, // 5^301
+  {LIT64(0x95527a5202df0ccb), LIT64(0x0f37801e0c43ebc8)}, // 5^302
+  {LIT64(0xbaa718e68396cffd), LIT64(0xd30560258f54e6ba)}, // 5^303
+  {LIT64(0xe950df20247c83fd), LIT64(0x47c6b82ef32a2069)}, // 5^304
+  {LIT64(0x91d28b7416cdd27e), LIT64(0x4cdc331d57fa5441)}, // 5^305
+  {LIT64(0xb6472e511c81471d), LIT64(0xe0133fe4adf8e952)}, // 5^306
+  {LIT64(0xe3d8f9e563a198e5), LIT64(0x58180fddd97723a6)}, // 5^307
+  {LIT64(0x8e679c2f5e44ff8f), LIT64(0x570f09eaa7ea7648)}, // 5^308
+  {LIT64(0xb201833b35d63f73), LIT64(0x2cd2cc6551e513da)}, // 5^309
+  {LIT64(0xde81e40a034bcf4f), LIT64(0xf8077f7ea65e58d1)}, // 5^310
+  {LIT64(0x8b112e86420f6191), LIT64(0xfb04afaf27faf782)}, // 5^311
+  {LIT64(0xadd57a27d29339f6), LIT64(0x79c5db9af1f9b563)}, // 5^312
+  {LIT64(0xd94ad8b1c7380874), LIT64(0x18375281ae7822bc)}, // 5^313
+  {LIT64(0x87cec76f1c830548), LIT64(0x8f2293910d0b15b5)}, // 5^314
+  {LIT64(0xa9c2794ae3a3c69a), LIT64(0xb2eb3875504ddb22)}, // 5^315
+  {LIT64(0xd433179d9c8cb841), LIT64(0x5fa60692a46151eb)}, // 5^316
+  {LIT64(0x849feec281d7f328), LIT64(0xdbc7c41ba6bcd333)}, // 5^317
+  {LIT64(0xa5c7ea73224deff3), LIT64(0x12b9b522906c0800)}, // 5^318
+  {LIT64(0xcf39e50feae16bef), LIT64(0xd768226b34870a00)}, // 5^319
+  {LIT64(0x81842f29f2cce375), LIT64(0xe6a1158300d46640)}, // 5^320
+  {LIT64(0xa1e53af46f801c53), LIT64(0x60495ae3c1097fd0)}, // 5^321
+  {LIT64(0xca5e89b18b602368), LIT64(0x385bb19cb14bdfc4)}, // 5^322
+  {LIT64(0xfcf62c1dee382c42), LIT64(0x46729e03dd9ed7b5)}, // 5^323
+  {LIT64(0x9e19db92b4e31ba9), LIT64(0x6c07a2c26a8346d1)}, // 5^324
+  {LIT64(0xc5a05277621be293), LIT64(0xc7098b7305241885)}, // 5^325
+  {LIT64(0xf70867153aa2db38), LIT64(0xb8cbee4fc66d1ea7)}  // 5^326
+};
+
+static const Uint64 POW10[20] = {
+  LIT64(1),
+  LIT64(10),
+  LIT64(100),
+  LIT64(1000),
+  LIT64(10000),
+  LIT64(100000),
+  LIT64(1000000),
+  LIT64(10000000),
+  LIT64(100000000),
+  LIT64(1000000000),
+  LIT64(10000000000),
+  LIT64(100000000000),
+  LIT64(1000000000000),
+  LIT64(10000000000000),
+  LIT64(100000000000000),
+  LIT64(1000000000000000),
+  LIT64(10000000000000000),
+  LIT64(100000000000000000),
+  LIT64(1000000000000000000),
+  LIT64(10000000000000000000)
+};
+
+static inline Bool is_digit(int ch) {
+  return (unsigned)ch - '0' <= 9u;
+}
+
+static inline Bool is_space(int ch) {
+  return ch == ' ' || (unsigned)ch - '\t' <= 4u;
+}
+
+static inline int hex_digit(int ch) {
+  if (is_digit(ch)) {
+    return ch - '0';
+  }
+  return (unsigned)(ch | 0x20) - 'a' <= 5u ? (ch | 0x20) - 'a' + 10 : -1;
+}
+
+// Case insensitive match of [word] at the start of [s].
+static Bool match_word(const char *s, const char *word) {
+  for (; *word; s++, word++) {
+    if ((*s | 0x20) != *word) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Parse an optional exponent introduced by [marker] into [exp], saturating at a
+// magnitude no literal can reach, returns where parsing stopped.
+static const char *parse_exponent(const char *s, char marker, Sint64 *exp) {
+  *exp = 0;
+  if ((*s | 0x20) != marker) {
+    return s;
+  }
+  const char *t = s + 1;
+  Flag negative = 0;
+  if (*t == '+' || *t == '-') {
+    negative = *t++ == '-';
+  }
+  if (!is_digit(*t)) {
+    return s;
+  }
+  for (; is_digit(*t); t++) {
+    if (*exp < ((Sint64)1 << 50)) {
+      *exp = *exp * 10 + (*t - '0');
+    }
+  }
+  if (negative) {
+    *exp = -*exp;
+  }
+  return t;
+}
+
+// The Eisel-Lemire algorithm: the 192-bit product of the normalized w and the
+// truncated 5^q gives the leading 64 bits of w * 10^q unless the truncation of
+// 5^q could carry into them, in which case this fails.
+static Bool lemire(Uint64 w, Sint32 q, Extended *x) {
+  const Sint16 lz = __builtin_clzll(w);
+  w <<= lz;
+  const Uint64 *t = POW5[q - POW5_MIN];
+  const Uint128 lo = uint128_mul64x64(w, t[1]);
+  const Uint128 hi = uint128_mul64x64(w, t[0]);
+  Uint64 z1 = hi.z1 + lo.z0;
+  Uint64 z0 = hi.z0 + (z1 < lo.z0);
+  Uint64 z2 = lo.z1;
+  const Sint16 shift = 1 - (z0 >> 63);
+  if (shift) {
+    z0 = (z0 << 1) | (z1 >> 63);
+    z1 = (z1 << 1) | (z2 >> 63);
+    z2 <<= 1;
+  }
+  // The truncation is less than w, shifted, below the low 128 bits.
+  const Flag exact = 0 <= q && q <= 55;
+  if (!exact && z1 >= LIT64(0xfffffffffffffffe)) {
+    return false;
+  }
+  // floor(q * log2(10)) for the exponent of 5^q * 2^q.
+  x->sig = z0;
+  x->exp = ((217706 * q) >> 16) + 1 - shift - lz;
+  x->sticky = !exact || (z1 | z2) != 0;
+  return true;
+}
+
+// Arbitrary precision unsigned integers, least significant word first, large
+// enough for the literals the slow path handles.
+#define BIG_WORDS 64
+#define BIG_DIGITS 800
+
+typedef struct Big Big;
+
+struct Big {
+  Uint64 words[BIG_WORDS];
+  Size size;
+};
+
+// a = a * mul + add
+static void big_mul_add(Big *a, Uint64 mul, Uint64 add) {
+  Uint64 carry = add;
+  for (Size i = 0; i < a->size; i++) {
+    const Uint128 p = uint128_mul64x64(a->words[i], mul);
+    const Uint64 word = p.z1 + carry;
+    carry = p.z0 + (word < carry);
+    a->words[i] = word;
+  }
+  if (carry) {
+    a->words[a->size++] = carry;
+  }
+}
+
+static void big_mul_pow10(Big *a, Size n) {
+  for (; n >= 19; n -= 19) {
+    big_mul_add(a, POW10[19], 0);
+  }
+  big_mul_add(a, POW10[n], 0);
+}
+
+static Size big_bits(const Big *a) {
+  return a->size ? 64 * a->size - __builtin_clzll(a->words[a->size - 1]) : 0;
+}
+
+static void big_shl(Big *a, Size count) {
+  const Size words = count / 64;
+  const Size bits = count % 64;
+  if (!a->size) {
+    return;
+  }
+  a->words[a->size + words] = 0;
+  for (Size i = a->size; i-- > 0; ) {
+    a->words[i + words + 1] |= bits ? a->words[i] >> (64 - bits) : 0;
+    a->words[i + words] = a->words[i] << bits;
+  }
+  for (Size i = 0; i < words; i++) {
+    a->words[i] = 0;
+  }
+  a->size += words + 1;
+  if (!a->words[a->size - 1]) {
+    a->size--;
+  }
+}
+
+static void big_shr1(Big *a) {
+  for (Size i = 0; i < a->size; i++) {
+    a->words[i] >>= 1;
+    if (i + 1 < a->size) {
+      a->words[i] |= a->words[i + 1] << 63;
+    }
+  }
+  if (a->size && !a->words[a->size - 1]) {
+    a->size--;
+  }
+}
+
+static int big_cmp(const Big *a, const Big *b) {
+  if (a->size != b->size) {
+    return a->size < b->size ? -1 : 1;
+  }
+  for (Size i = a->size; i-- > 0; ) {
+    if (a->words[i] != b->words[i]) {
+      return a->words[i] < b->words[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+// a = a - b where a >= b
+static void big_sub(Big *a, const Big *b) {
+  Uint64 borrow = 0;
+  for (Size i = 0; i < a->size; i++) {
+    const Uint64 word = i < b->size ? b->words[i] : 0;
+    const Uint64 diff = a->words[i] - word - borrow;
+    borrow = a->words[i] < word || (a->words[i] == word && borrow);
+    a->words[i] = diff;
+  }
+  while (a->size && !a->words[a->size - 1]) {
+    a->size--;
+  }
+}
+
+// The exact value of the [count] significant digits starting at [first], which
+// may have a '.' among them, times 10^exp. Only the leading BIG_DIGITS digits
+// are kept and the rest only matter for being zero or not, as no value where
+// rounding changes has that many significant digits.
+static void slow(const char *first, Size count, Sint64 exp, Extended *x) {
+  const Size kept = count < BIG_DIGITS ? count : BIG_DIGITS;
+  Big n = { .size = 0 };
+  Big d = { .words = { 1 }, .size = 1 };
+  Uint64 chunk = 0;
+  Size chunked = 0;
+  Flag sticky = 0;
+  const char *s = first;
+  for (Size i = 0; i < count; s++) {
+    if (*s == '.') {
+      continue;
+    }
+    if (i++ >= kept) {
+      sticky |= *s != '0';
+      continue;
+    }
+    chunk = chunk * 10 + (*s - '0');
+    if (++chunked == 19) {
+      big_mul_add(&n, POW10[19], chunk);
+      chunk = 0;
+      chunked = 0;
+    }
+  }
+  big_mul_add(&n, POW10[chunked], chunk);
+  exp += count - kept;
+  if (exp >= 0) {
+    big_mul_pow10(&n, exp);
+  } else {
+    big_mul_pow10(&d, -exp);
+  }
+
+  // Scale to 2^63 <= n / d < 2^64 and take the quotient a bit at a time.
+  Sint32 k = (Sint32)big_bits(&d) - (Sint32)big_bits(&n) + 63;
+  if (k > 0) {
+    big_shl(&n, k);
+  } else {
+    big_shl(&d, -k);
+  }
+  big_shl(&d, 63);
+  if (big_cmp(&n, &d) < 0) {
+    big_shl(&n, 1);
+    k++;
+  }
+  Uint64 q = 0;
+  for (Sint16 i = 0; i < 64; i++) {
+    q <<= 1;
+    if (big_cmp(&n, &d) >= 0) {
+      big_sub(&n, &d);
+      q |= 1;
+    }
+    big_shr1(&d);
+  }
+  x->sig = q;
+  x->exp = -k;
+  x->sticky = sticky || n.size != 0;
+}
+
+static Parsed parse_hex(const char *s, char **next, Extended *x) {
+  Uint64 w = 0;
+  Sint64 exp = 0;
+  Size nibbles = 0;
+  Flag sticky = 0;
+  Bool point = false;
+  for (;; s++) {
+    const int h = hex_digit(*s);
+    if (h >= 0) {
+      exp -= point ? 4 : 0;
+      if (nibbles < 16) {
+        w = (w << 4) | h;
+        nibbles += w != 0;
+      } else {
+        sticky |= h != 0;
+        exp += 4;
+      }
+    } else if (*s == '.' && !point) {
+      point = true;
+    } else {
+      break;
+    }
+  }
+  Sint64 bias;
+  s = parse_exponent(s, 'p', &bias);
+  *next = (char *)s;
+  if (!w) {
+    return PARSED_ZERO;
+  }
+  exp += bias;
+  if (exp > 5000) {
+    *x = EXTENDED_HUGE;
+  } else if (exp < -5000) {
+    *x = EXTENDED_TINY;
+  } else {
+    const Sint16 lz = __builtin_clzll(w);
+    *x = (Extended){w << lz, exp - lz, sticky};
+  }
+  return PARSED_FINITE;
+}
+
+static Parsed parse(const char *string, char **next, Flag *sign, Extended *x) {
+  const char *s = string;
+  *next = (char *)string;
+  *sign = 0;
+  while (is_space(*s)) {
+    s++;
+  }
+  const Flag negative = *s == '-';
+  if (*s == '-' || *s == '+') {
+    s++;
+  }
+
+  if (match_word(s, "inf")) {
+    *sign = negative;
+    *next = (char *)s + (match_word(s, "infinity") ? 8 : 3);
+    return PARSED_INF;
+  }
+  if (match_word(s, "nan")) {
+    *sign = negative;
+    s += 3;
+    if (*s == '(') {
+      // An optional n-char-sequence, which is ignored.
+      const char *t = s + 1;
+      while (is_digit(*t) || (unsigned)(*t | 0x20) - 'a' <= 25u || *t == '_') {
+        t++;
+      }
+      if (*t == ')') {
+        s = t + 1;
+      }
+    }
+    *next = (char *)s;
+    return PARSED_NAN;
+  }
+  if (s[0] == '0' && (s[1] | 0x20) == 'x'
+    && (hex_digit(s[2]) >= 0 || (s[2] == '.' && hex_digit(s[3]) >= 0)))
+  {
+    *sign = negative;
+    return parse_hex(s + 2, next, x);
+  }
+
+  // The first 19 significant digits are gathered in w.
+  const char *first = NULL;
+  Uint64 w = 0;
+  Size count = 0;
+  Size fraction = 0;
+  Flag truncated = 0;
+  Bool point = false;
+  Bool digits = false;
+  for (;; s++) {
+    if (is_digit(*s)) {
+      digits = true;
+      fraction += point;
+      if (first || *s != '0') {
+        first = first ? first : s;
+        if (count++ < 19) {
+          w = w * 10 + (*s - '0');
+        } else {
+          truncated |= *s != '0';
+        }
+      }
+    } else if (*s == '.' && !point) {
+      point = true;
+    } else {
+      break;
+    }
+  }
+  if (!digits) {
+    return PARSED_NONE;
+  }
+  Sint64 exp;
+  s = parse_exponent(s, 'e', &exp);
+  *sign = negative;
+  *next = (char *)s;
+  if (!first) {
+    return PARSED_ZERO;
+  }
+
+  // The value is w * 10^q, or a little more when truncated.
+  exp -= fraction;
+  const Size kept = count < 19 ? count : 19;
+  if (exp + (Sint64)count > LITERAL_MAX) {
+    *x = EXTENDED_HUGE;
+    return PARSED_FINITE;
+  }
+  if (exp + (Sint64)count < LITERAL_MIN) {
+    *x = EXTENDED_TINY;
+    return PARSED_FINITE;
+  }
+  const Sint32 q = exp + (Sint64)(count - kept);
+  if (lemire(w, q, x)) {
+    // The value is in [w * 10^q, (w + 1) * 10^q) so both must agree.
+    Extended y;
+    if (!truncated) {
+      return PARSED_FINITE;
+    }
+    if (lemire(w + 1, q, &y) && y.sig == x->sig && y.exp == x->exp) {
+      x->sticky = 1;
+      return PARSED_FINITE;
+    }
+  }
+  slow(first, count, exp, x);
+  return PARSED_FINITE;
+}
+
+Float32 float32_from_string(Context *ctx, const char *string, char **next) {
+  Flag sign;
+  Extended x;
+  switch (parse(string, next, &sign, &x)) {
+  case PARSED_NONE:
+  case PARSED_ZERO:
+    return float32_pack(sign, 0, 0);
+  case PARSED_INF:
+    return float32_pack(sign, 0xff, 0);
+  case PARSED_NAN:
+    return float32_pack(sign, 0xff, LIT32(0x00400000));
+  case PARSED_FINITE:
+    break;
+  }
+  return float32_round_and_pack(ctx, sign, x.exp + 189, rshr64(x.sig, 33) | x.sticky);
+}
+
+Float64 float64_from_string(Context *ctx, const char *string, char **next) {
+  Flag sign;
+  Extended x;
+  switch (parse(string, next, &sign, &x)) {
+  case PARSED_NONE:
+  case PARSED_ZERO:
+    return float64_pack(sign, 0, 0);
+  case PARSED_INF:
+    return float64_pack(sign, 0x7ff, 0);
+  case PARSED_NAN:
+    return float64_pack(sign, 0x7ff, LIT64(0x0008000000000000));
+  case PARSED_FINITE:
+    break;
+  }
+  return float64_round_and_pack(ctx, sign, x.exp + 1085, rshr64(x.sig, 1) | x.sticky);
+}
+
+// The shortest decimal digits * 10^exp that rounds back to the float it was
+// made from.
+typedef struct Decimal Decimal;
+
+struct Decimal {
+  Uint64 digits;
+  Sint32 exp;
+};
+
+// The high 64 bits of the 192-bit g * cp, rounded to odd.
+static inline Uint64 round_to_odd(const Uint64 *g, Uint64 cp) {
+  const Uint128 lo = uint128_mul64x64(g[1], cp);
+  const Uint128 hi = uint128_mul64x64(g[0], cp);
+  const Uint64 z1 = hi.z1 + lo.z0;
+  const Uint64 z0 = hi.z0 + (z1 < lo.z0);
+  return z0 | (z1 > 1);
+}
+
+// Raffaello Giulietti's Schubfach algorithm on the value c * 2^q, where the
+// float below is closer than the one above when [closer] is set, which only
+// happens at powers of two. The precision of c only has to stay well within
+// 64 bits, so both formats share this.
+static Decimal schubfach(Uint64 c, Sint32 q, Flag closer) {
+  // floor(log10(2^q)) or floor(log10(3/4 * 2^q)) when closer, and h chosen
+  // so the scaled interval bounds below land in the high 64 bits.
+  const Sint32 k = (q * 1262611 - (closer ? 524031 : 0)) >> 22;
+  const Sint32 h = q + ((-k * 1741647) >> 19) + 1;
+  // The algorithm wants 10^-k rounded up rather than truncated.
+  const Uint64 *t = POW5[-k - POW5_MIN];
+  const Uint64 g[2] = { t[0] + (t[1] == LIT64(0xffffffffffffffff)), t[1] + 1 };
+  const Flag even = !(c & 1);
+  const Uint64 vbl = round_to_odd(g, (4 * c - 2 + closer) << h);
+  const Uint64 vb = round_to_odd(g, (4 * c) << h);
+  const Uint64 vbr = round_to_odd(g, (4 * c + 2) << h);
+  const Uint64 lower = vbl + !even;
+  const Uint64 upper = vbr - !even;
+  const Uint64 s = vb / 4;
+  if (s >= 10) {
+    // One digit less when just one multiple of ten near s is inside.
+    const Uint64 sp = s / 10;
+    const Bool up_inside = lower <= 40 * sp;
+    const Bool wp_inside = 40 * sp + 40 <= upper;
+    if (up_inside != wp_inside) {
+      return (Decimal){sp + wp_inside, k + 1};
+    }
+  }
+  const Bool u_inside = lower <= 4 * s;
+  const Bool w_inside = 4 * s + 4 <= upper;
+  if (u_inside != w_inside) {
+    return (Decimal){s + w_inside, k};
+  }
+  // Both or neither are inside, take the closest, ties to even.
+  const Uint64 mid = 4 * s + 2;
+  return (Decimal){s + (vb > mid || (vb == mid && (s & 1))), k};
+}
+
+static Decimal shortest(Uint64 c, Sint32 q, Flag closer) {
+  Decimal d;
+  if (-52 <= q && q <= 0 && !(c & ((LIT64(1) << -q) - 1))) {
+    // Integers are exact.
+    d = (Decimal){c >> -q, 0};
+  } else {
+    d = schubfach(c, q, closer);
+  }
+  while (d.digits % 10 == 0) {
+    d.digits /= 10;
+    d.exp++;
+  }
+  return d;
+}
+
+// The sign followed by [text], for zeros, infinities and NaNs.
+static Size write_text(char *buffer, Flag sign, const char *text) {
+  char *p = buffer;
+  if (sign) {
+    *p++ = '-';
+  }
+  while (*text) {
+    *p++ = *text++;
+  }
+  *p = '\0';
+  return p - buffer;
+}
+
+// Digits followed by "e" and the exponent when it is below -4 or above 16 like
+// "%.17g" would, but without padding.
+static Size write_decimal(char *buffer, Flag sign, Decimal d) {
+  char digits[20];
+  Sint32 length = 0;
+  for (Uint64 v = d.digits; v; v /= 10) {
+    digits[length++] = '0' + v % 10;
+  }
+  // The position of the decimal point relative to the first digit.
+  const Sint32 point = d.exp + length;
+  char *p = buffer;
+  if (sign) {
+    *p++ = '-';
+  }
+  if (point < -3 || point > 17) {
+    *p++ = digits[length - 1];
+    if (length > 1) {
+      *p++ = '.';
+      for (Sint32 i = length - 2; i >= 0; i--) {
+        *p++ = digits[i];
+      }
+    }
+    Sint32 exp = point - 1;
+    *p++ = 'e';
+    *p++ = exp < 0 ? '-' : '+';
+    exp = exp < 0 ? -exp : exp;
+    if (exp >= 100) {
+      *p++ = '0' + exp / 100;
+    }
+    if (exp >= 10) {
+      *p++ = '0' + exp / 10 % 10;
+    }
+    *p++ = '0' + exp % 10;
+  } else if (point <= 0) {
+    *p++ = '0';
+    *p++ = '.';
+    for (Sint32 i = point; i < 0; i++) {
+      *p++ = '0';
+    }
+    for (Sint32 i = length - 1; i >= 0; i--) {
+      *p++ = digits[i];
+    }
+  } else {
+    for (Sint32 i = length - 1; i >= 0; i--) {
+      *p++ = digits[i];
+      if (i == length - point && i) {
+        *p++ = '.';
+      }
+    }
+    for (Sint32 i = length; i < point; i++) {
+      *p++ = '0';
+    }
+  }
+  *p = '\0';
+  return p - buffer;
+}
+
+// "0x1." and the hexadecimal digits of [sig] below its leading bit 63, then
+// "p" and the exponent of the leading bit.
+static Size write_hex(char *buffer, Flag sign, Uint64 sig, Sint32 exp) {
+  static const char HEX[] = "0123456789abcdef";
+  char *p = buffer;
+  if (sign) {
+    *p++ = '-';
+  }
+  *p++ = '0';
+  *p++ = 'x';
+  *p++ = '1';
+  sig <<= 1;
+  if (sig) {
+    *p++ = '.';
+  }
+  for (; sig; sig <<= 4) {
+    *p++ = HEX[sig >> 60];
+  }
+  *p++ = 'p';
+  *p++ = exp < 0 ? '-' : '+';
+  exp = exp < 0 ? -exp : exp;
+  if (exp >= 1000) {
+    *p++ = '0' + exp / 1000;
+  }
+  if (exp >= 100) {
+    *p++ = '0' + exp / 100 % 10;
+  }
+  if (exp >= 10) {
+    *p++ = '0' + exp / 10 % 10;
+  }
+  *p++ = '0' + exp % 10;
+  *p = '\0';
+  return p - buffer;
+}
+
+Size float32_to_string(char *buffer, Float32 a) {
+  const Uint32 a_sig = float32_fract(a);
+  const Sint16 a_exp = float32_exp(a);
+  const Flag a_sign = float32_sign(a);
+  if (a_exp == 0xff) {
+    return write_text(buffer, a_sign, a_sig ? "nan" : "inf");
+  }
+  if (!a_exp) {
+    return a_sig
+      ? write_decimal(buffer, a_sign, shortest(a_sig, -149, 0))
+      : write_text(buffer, a_sign, "0");
+  }
+  return write_decimal(buffer, a_sign,
+    shortest(a_sig | LIT32(0x00800000), a_exp - 150, !a_sig && a_exp > 1));
+}
+
+Size float64_to_string(char *buffer, Float64 a) {
+  const Uint64 a_sig = float64_fract(a);
+  const Sint16 a_exp = float64_exp(a);
+  const Flag a_sign = float64_sign(a);
+  if (a_exp == 0x7ff) {
+    return write_text(buffer, a_sign, a_sig ? "nan" : "inf");
+  }
+  if (!a_exp) {
+    return a_sig
+      ? write_decimal(buffer, a_sign, shortest(a_sig, -1074, 0))
+      : write_text(buffer, a_sign, "0");
+  }
+  return write_decimal(buffer, a_sign,
+    shortest(a_sig | LIT64(0x0010000000000000), a_exp - 1075, !a_sig && a_exp > 1));
+}
+
+// Subnormals are normalized, as the leading digit is always 1.
+Size float32_to_hex(char *buffer, Float32 a) {
+  const Uint32 a_sig = float32_fract(a);
+  const Sint16 a_exp = float32_exp(a);
+  const Flag a_sign = float32_sign(a);
+  if (a_exp == 0xff) {
+    return write_text(buffer, a_sign, a_sig ? "nan" : "inf");
+  }
+  if (!a_exp && !a_sig) {
+    return write_text(buffer, a_sign, "0x0p+0");
+  }
+  const Uint64 sig = a_exp ? a_sig | LIT32(0x00800000) : a_sig;
+  const Sint16 shift = __builtin_clzll(sig);
+  return write_hex(buffer, a_sign, sig << shift, (a_exp ? a_exp : 1) - 127 + 40 - shift);
+}
+
+Size float64_to_hex(char *buffer, Float64 a) {
+  const Uint64 a_sig = float64_fract(a);
+  const Sint16 a_exp = float64_exp(a);
+  const Flag a_sign = float64_sign(a);
+  if (a_exp == 0x7ff) {
+    return write_text(buffer, a_sign, a_sig ? "nan" : "inf");
+  }
+  if (!a_exp && !a_sig) {
+    return write_text(buffer, a_sign, "0x0p+0");
+  }
+  const Uint64 sig = a_exp ? a_sig | LIT64(0x0010000000000000) : a_sig;
+  const Sint16 shift = __builtin_clzll(sig);
+  return write_hex(buffer, a_sign, sig << shift, (a_exp ? a_exp : 1) - 1023 + 11 - shift);
+}
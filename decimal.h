@@ -0,0 +1,34 @@
+#ifndef DECIMAL_H
+#define DECIMAL_H
+#include "soft.h"
+
+// Conversion between strings and floating-point.
+//
+// Parsing accepts what strtod does: leading white space, an optional sign, then
+// decimal digits with an optional '.' and 'e' exponent, "0x" and hexadecimal
+// digits with an optional '.' and 'p' binary exponent, or "inf", "infinity"
+// and "nan" in any case.
+//
+// Results are correctly rounded in the rounding mode of the context, and
+// inexact, overflow and underflow are raised the same way arithmetic raises
+// them. [next] is set past the last character used, or to [string] when
+// nothing could be parsed, in which case the result is zero.
+Float32 float32_from_string(Context*, const char *string, char **next);
+Float64 float64_from_string(Context*, const char *string, char **next);
+
+// Size of a buffer that holds anything the functions below write, including
+// the terminating NUL.
+#define DECIMAL_CAPACITY 32
+
+// The shortest decimal string that reads back as the same float, in the form
+// "%.17g" uses but without padding the exponent, such as "0.1", "-2.5e-7",
+// "1e+30", "-0", "inf" and "nan". Returns the length, writing is always exact
+// and never allocates.
+Size float32_to_string(char *buffer, Float32);
+Size float64_to_string(char *buffer, Float64);
+
+// The exact value in hexadecimal, such as "0x1.99999ap-4" or "0x0p+0".
+Size float32_to_hex(char *buffer, Float32);
+Size float64_to_hex(char *buffer, Float64);
+
+#endif // DECIMAL_H
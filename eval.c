@@ -1,39 +1,79 @@
-#include <stdlib.h> // calloc, free
-#include <string.h> // strchr
+#include <setjmp.h> // jmp_buf, setjmp
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <string.h> // strchr, strcmp, strncmp, memcpy, memset
 #include <stdio.h> // fprintf, stderr
+#include <time.h> // clock_gettime
 
+#include "decimal.h"
 #include "eval.h"
 
 typedef struct Parser Parser;
+typedef struct Literal Literal;
+typedef struct Node Node;
+typedef struct Variable Variable;
+typedef struct Memo Memo;
 typedef struct Expression Expression;
 
-struct Expression {
-  enum {
-    EXPR_VALUE,
-    EXPR_CONST,
-    EXPR_FUNC1, EXPR_FUNC2,
-    EXPR_EQ, EXPR_LTE, EXPR_LT,
-    EXPR_NE, EXPR_GTE, EXPR_GT,
-    EXPR_ADD, EXPR_SUB, EXPR_MUL, EXPR_DIV,
-    EXPR_LAST
-  } type;
-  Real32 value;
+enum {
+  EXPR_VALUE,
+  EXPR_CONST,
+  EXPR_VAR,
+  EXPR_FUNC1, EXPR_FUNC2, EXPR_FUNC3,
+  EXPR_EQ, EXPR_LTE, EXPR_LT,
+  EXPR_NE, EXPR_GTE, EXPR_GT,
+  EXPR_ADD, EXPR_SUB, EXPR_MUL, EXPR_DIV,
+  EXPR_LAST
+};
+
+enum {
+  // EXPR_FUNC1
+  FUNC_FLOOR,
+  FUNC_CEIL,
+  FUNC_TRUNC,
+  FUNC_SQRT,
+  FUNC_ABS,
+  // EXPR_FUNC2
+  FUNC_MIN,
+  FUNC_MAX,
+  FUNC_COPYSIGN,
+  // EXPR_FUNC3
+  FUNC_FMA
+};
+
+// Nodes refer to their parameters by index into the node pool of the owning
+// expression, index 0 is reserved to mean no parameter.
+struct Node {
+  Uint8 type;
   union {
-    Size constant;
-    enum {
-      // EXPR_FUNC1
-      FUNC_FLOOR,
-      FUNC_CEIL,
-      FUNC_TRUNC,
-      FUNC_SQRT,
-      FUNC_ABS,
-      // EXPR_FUNC2
-      FUNC_MIN,
-      FUNC_MAX,
-      FUNC_COPYSIGN
-    } func;
+    Uint8 constant;
+    Uint8 variable;
+    Uint8 func;
+    Uint8 raised; ///< By rounding the literal of an EXPR_VALUE.
   };
-  Expression* params[2];
+  Uint32 params[3];
+  Real32 value;
+};
+
+struct Variable {
+  char name[EXPR_VARIABLE_LENGTH + 1];
+  Real32 value;
+};
+
+// Every node of an expression lives in a single allocation following this
+// header so the whole tree is released at once by expr_free.
+//
+// Structurally identical subexpressions are parsed into the same node, which
+// makes the nodes a DAG rather than a tree when [shared] is non-zero, and then
+// [memo] holds a Memo per node for the evaluation numbered [evaluation].
+struct Expression {
+  Uint32 root;
+  Uint32 size;
+  Uint32 shared; ///< Number of times an existing node was reused.
+  Uint32 evaluation;
+  Memo *memo;
+  Uint32 n_variables;
+  Variable variables[EXPR_MAX_VARIABLES];
+  Node nodes[];
 };
 
 static const struct {
@@ -67,6 +107,13 @@ static const struct {
   { "copysign", FUNC_COPYSIGN }
 };
 
+static const struct {
+  const char *match;
+  Uint32 func;
+} FUNCS3[] = {
+  { "fma", FUNC_FMA }
+};
+
 #define ARRAY_COUNT(x) \
   (sizeof (x) / sizeof (*(x)))
 
@@ -88,10 +135,28 @@ static const char *func2_name(Uint32 func) {
   return NULL;
 }
 
-// This is cheating for now until we implement an accurate strtof, strtod, etc.
-static Real32 real32_from_string(const char *string, char **next) {
-  union { float f; Float32 s; } u = {strtof(string, next)};
-  return (Real32){u.s, {0}};
+static const char *func3_name(Uint32 func) {
+  for (Size i = 0; i < ARRAY_COUNT(FUNCS3); i++) {
+    if (FUNCS3[i].func == func) {
+      return FUNCS3[i].match;
+    }
+  }
+  return NULL;
+}
+
+// Literals are correctly rounded in the rounding mode of the context, and
+// carry the error of that rounding when inexact. What it raised is left in the
+// otherwise reset context.
+static Real32 real32_from_string(Context *ctx, const char *string, char **next) {
+  context_reset(ctx);
+  const Float32 value = float32_from_string(ctx, string, next);
+  if (!(ctx->raised & EXCEPTION_INEXACT)) {
+    return (Real32){value, {0}};
+  }
+  const Exception raised = ctx->raised;
+  const Real32 result = real32_rounded(ctx, value);
+  ctx->raised = raised;
+  return result;
 }
 
 static Bool is_identifier(int ch) {
@@ -111,48 +176,77 @@ static bool match(const char *s, const char *prefix) {
   return !is_identifier(s[i]); // Should be terminated identifier.
 }
 
+// Text of the literal an EXPR_VALUE node was parsed from, in the input.
+struct Literal {
+  Uint32 offset;
+  Uint32 length;
+};
+
 struct Parser {
+  Context ctx;   ///< Rounds literals, what they raise is kept in their node.
   Sint32 level;
   char *s;
+  const char *input;  ///< Whitespace-stripped copy of the input.
+  Expression *e;
+  Uint32 *table;      ///< Open addressed hash of node indices, 0 is empty.
+  Uint32 mask;
+  Literal *literals;  ///< Per node, for EXPR_VALUE nodes only.
 };
 
-#define ALU(fp, op) \
-    fprintf(fp, "("); \
-    expr_print(fp, expression->params[0]); \
-    fprintf(fp, " %s ", op); \
-    expr_print(fp, expression->params[1]); \
-    fprintf(fp, ")"); \
+#define ALU(writer, op) \
+    writer_char(writer, '('); \
+    print(writer, expression, node->params[0]); \
+    writer_printf(writer, " %s ", op); \
+    print(writer, expression, node->params[1]); \
+    writer_char(writer, ')'); \
     break
 
-void expr_print(FILE *fp, Expression *expression) {
-  switch (expression->type) {
+static void print(Writer *writer, const Expression *expression, Uint32 index) {
+  const Node *node = &expression->nodes[index];
+  switch (node->type) {
   case EXPR_VALUE:
-    fprintf(fp, "%f", float32_cast(expression->value.value));
+    writer_float32(writer, node->value.value);
     break;
   case EXPR_CONST:
-    fprintf(fp, "%s", CONSTANTS[expression->constant].identifier);
+    writer_string(writer, CONSTANTS[node->constant].identifier);
+    break;
+  case EXPR_VAR:
+    writer_string(writer, expression->variables[node->variable].name);
     break;
   case EXPR_FUNC1:
-    fprintf(fp, "%s(", func1_name(expression->func));
-    expr_print(fp, expression->params[0]);
-    fprintf(fp, ")");
+    writer_printf(writer, "%s(", func1_name(node->func));
+    print(writer, expression, node->params[0]);
+    writer_char(writer, ')');
     break;
   case EXPR_FUNC2:
-    fprintf(fp, "%s(", func2_name(expression->func));
-    expr_print(fp, expression->params[0]);
-    fprintf(fp, ", ");
-    expr_print(fp, expression->params[1]);
-    fprintf(fp, ")");
+    writer_printf(writer, "%s(", func2_name(node->func));
+    print(writer, expression, node->params[0]);
+    writer_string(writer, ", ");
+    print(writer, expression, node->params[1]);
+    writer_char(writer, ')');
     break;
-  case EXPR_ADD: ALU(fp, "+");
-  case EXPR_SUB: ALU(fp, "-");
-  case EXPR_MUL: ALU(fp, "*");
-  case EXPR_DIV: ALU(fp, "/");
+  case EXPR_FUNC3:
+    writer_printf(writer, "%s(", func3_name(node->func));
+    print(writer, expression, node->params[0]);
+    writer_string(writer, ", ");
+    print(writer, expression, node->params[1]);
+    writer_string(writer, ", ");
+    print(writer, expression, node->params[2]);
+    writer_char(writer, ')');
+    break;
+  case EXPR_ADD: ALU(writer, "+");
+  case EXPR_SUB: ALU(writer, "-");
+  case EXPR_MUL: ALU(writer, "*");
+  case EXPR_DIV: ALU(writer, "/");
   default:
     break;
   }
 }
 
+void expr_print(Writer *writer, const Expression *expression) {
+  print(writer, expression, expression->root);
+}
+
 static Real32 eval_func1_32(Context *ctx, Uint32 func, Real32 a) {
   switch (func) {
   case FUNC_FLOOR:
@@ -181,21 +275,117 @@ static Real32 eval_func2_32(Context *ctx, Uint32 func, Real32 a, Real32 b) {
   return (Real32){FLOAT32_ZERO, {0}};
 }
 
-Real32 expr_eval32(Context *ctx, Expression *expression) {
-  if (!expression) {
-    return REAL32_ZERO;
+static Real32 eval_func3_32(Context *ctx, Uint32 func, Real32 a, Real32 b, Real32 c) {
+  switch (func) {
+  case FUNC_FMA:
+    return real32_fma(ctx, a, b, c);
   }
+  return (Real32){FLOAT32_ZERO, {0}};
+}
 
-  Real32 a = expr_eval32(ctx, expression->params[0]);
-  Real32 b = expr_eval32(ctx, expression->params[1]);
+// The result of a shared node along with the events and roundings its first
+// evaluation recorded, so that later uses replay them into the context and are
+// reported as if they had been evaluated again. Memos of earlier evaluations
+// are told apart by their number, so the array is never cleared.
+struct Memo {
+  Real32 value;
+  Size events;
+  Size exceptions;
+  Size operations;
+  Size roundings;
+  Uint32 evaluation;
+};
 
-  Real32 result = REAL32_ZERO;
+// Unless every record is still kept they are only counted again, the flags
+// they raised are sticky in the context already.
+static Real32 replay(Context *ctx, const Memo *memo) {
+  const Size count = memo->exceptions + memo->operations;
+  Bool kept = true;
+  for (Size i = 0; i < count && kept; i++) {
+    kept = context_record(ctx, memo->events + i) != NULL;
+  }
+  if (kept) {
+    for (Size i = 0; i < count; i++) {
+      const Record record = *context_record(ctx, memo->events + i);
+      if (record.kind == EVENT_EXCEPTION) {
+        context_raise(ctx, record.value);
+      } else {
+        context_operation(ctx, record.value);
+      }
+    }
+  } else {
+    ctx->n_exceptions += memo->exceptions;
+    ctx->n_operations += memo->operations;
+  }
+  ctx->roundings += memo->roundings;
+  return memo->value;
+}
+
+static void record(Trace *trace, const Context *ctx, Uint32 index, Size events) {
+  for (Uint8 kind = EVENT_EXCEPTION; kind <= EVENT_OPERATION; kind++) {
+    for (Size i = events; i < context_events(ctx); i++) {
+      const Record *record = context_record(ctx, i);
+      if (record && record->kind == kind) {
+        const Event event = { index, record->index, kind, record->value };
+        array_push(trace->events, event);
+      }
+    }
+  }
+}
+
+static Real32 eval32(Context*, const Expression*, Memo*, Trace*, Uint32);
+
+static Uint64 now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (Uint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static Bool is_leaf(const Node *node) {
+  return node->type == EXPR_VALUE || node->type == EXPR_CONST || node->type == EXPR_VAR;
+}
+
+// A literal raises again what rounding it raised, without trapping as it is
+// not an operation.
+static inline Real32 eval_value(Context *ctx, const Node *node) {
+  if (node->raised) {
+    context_raise(ctx, node->raised);
+  }
+  return node->value;
+}
+
+static Real32 eval32_node(Context *ctx, const Expression *expression, Memo *memo, Trace *trace, Uint32 index) {
+  const Node *node = &expression->nodes[index];
+
+  const Size events = context_events(ctx);
+  const Size exceptions = ctx->n_exceptions;
+  const Size operations = ctx->n_operations;
+  const Size roundings = ctx->roundings;
+
+  if (memo && memo[index].evaluation == expression->evaluation) {
+    const Real32 result = replay(ctx, &memo[index]);
+    if (trace) {
+      record(trace, ctx, index, events);
+    }
+    return result;
+  }
 
-  switch (expression->type) {
-  /****/ case EXPR_VALUE: result = expression->value;
-  break; case EXPR_CONST: result = CONSTANTS[expression->constant].value;
-  break; case EXPR_FUNC1: result = eval_func1_32(ctx, expression->func, a);
-  break; case EXPR_FUNC2: result = eval_func2_32(ctx, expression->func, a, b);
+  Real32 a = eval32(ctx, expression, memo, trace, node->params[0]);
+  Real32 b = eval32(ctx, expression, memo, trace, node->params[1]);
+  Real32 c = eval32(ctx, expression, memo, trace, node->params[2]);
+  ctx->node = index;
+
+  // Only what this node did itself, its operands have recorded their own.
+  const Size own = context_events(ctx);
+
+  Real32 result = REAL32_ZERO;
+  switch (node->type) {
+  /****/ case EXPR_VALUE: result = eval_value(ctx, node);
+  break; case EXPR_CONST: result = CONSTANTS[node->constant].value;
+  break; case EXPR_VAR:   result = expression->variables[node->variable].value;
+  break; case EXPR_FUNC1: result = eval_func1_32(ctx, node->func, a);
+  break; case EXPR_FUNC2: result = eval_func2_32(ctx, node->func, a, b);
+  break; case EXPR_FUNC3: result = eval_func3_32(ctx, node->func, a, b, c);
   break; case EXPR_EQ:    result = real32_eq(ctx, a, b);
   break; case EXPR_LTE:   result = real32_lte(ctx, a, b);
   break; case EXPR_LT:    result = real32_lt(ctx, a, b);
@@ -210,164 +400,617 @@ Real32 expr_eval32(Context *ctx, Expression *expression) {
   break;
   }
 
-  Size n_operations = array_size(ctx->operations);
-  Size n_exceptions = array_size(ctx->exceptions);
+  if (trace) {
+    record(trace, ctx, index, own);
+  }
+
+  if (memo) {
+    memo[index] = (Memo){
+      result,
+      events,
+      ctx->n_exceptions - exceptions,
+      ctx->n_operations - operations,
+      ctx->roundings - roundings,
+      expression->evaluation
+    };
+  }
+
+  return result;
+}
+
+// Spans are pushed when a node is entered and closed when it returns, so the
+// operands of a node always follow it.
+static Real32 eval32_timed(Context *ctx, const Expression *expression, Memo *memo, Trace *trace, Uint32 index) {
+  const Size span = array_size(trace->spans);
+  const Span entered = { index, trace->open, 0, 0 };
+  if (!array_push(trace->spans, entered)) {
+    return eval32_node(ctx, expression, memo, trace, index);
+  }
+  trace->open = span;
+  trace->spans[span].begin = now();
+  const Real32 result = eval32_node(ctx, expression, memo, trace, index);
+  trace->spans[span].end = now();
+  trace->open = entered.parent;
+  return result;
+}
+
+static Real32 eval32(Context *ctx, const Expression *expression, Memo *memo, Trace *trace, Uint32 index) {
+  if (!index) {
+    return REAL32_ZERO;
+  }
+  if (trace && trace->timed && !is_leaf(&expression->nodes[index])) {
+    return eval32_timed(ctx, expression, memo, trace, index);
+  }
+  return eval32_node(ctx, expression, memo, trace, index);
+}
+
+// A trap that aborts unwinds to here from however deep the evaluation is, the
+// spans still open then end at the abort.
+static Real32 eval32_root(Context *ctx, const Expression *expression, Memo *memo, Trace *trace) {
+  if (!ctx->trapping) {
+    return eval32(ctx, expression, memo, trace, expression->root);
+  }
+  jmp_buf abort;
+  jmp_buf *const outer = ctx->abort;
+  ctx->abort = &abort;
+  if (setjmp(abort)) {
+    ctx->abort = outer;
+    if (trace && trace->timed) {
+      const Uint64 end = now();
+      for (Uint32 span = trace->open; span != TRACE_ROOT; span = trace->spans[span].parent) {
+        trace->spans[span].end = end;
+      }
+    }
+    return REAL32_NAN;
+  }
+  const Real32 result = eval32(ctx, expression, memo, trace, expression->root);
+  ctx->abort = outer;
+  return result;
+}
+
+Real32 expr_eval32(Context *ctx, Expression *expression, Trace *trace) {
+  ctx->aborted = false;
+  if (trace) {
+    trace->open = TRACE_ROOT;
+  }
+  if (!expression->shared) {
+    return eval32_root(ctx, expression, NULL, trace);
+  }
+  // Memos start out at zero, which no evaluation is numbered.
+  if (!++expression->evaluation) {
+    memset(expression->memo, 0, expression->size * sizeof *expression->memo);
+    expression->evaluation = 1;
+  }
+  return eval32_root(ctx, expression, expression->memo, trace);
+}
+
+void trace_init(Trace *trace) {
+  trace->events = NULL;
+  trace->spans = NULL;
+  trace->timed = false;
+  trace->open = TRACE_ROOT;
+}
+
+void trace_free(Trace *trace) {
+  array_free(trace->events);
+  array_free(trace->spans);
+}
+
+// Leaves are printed in full, anything else by reference to its node.
+static void print_operand(Writer *writer, const Expression *expression, Uint32 index) {
+  switch (expression->nodes[index].type) {
+  case EXPR_VALUE: // fallthrough
+  case EXPR_CONST: // fallthrough
+  case EXPR_VAR:
+    print(writer, expression, index);
+    break;
+  default:
+    writer_printf(writer, "#%u", index);
+    break;
+  }
+}
+
+#define SHALLOW_ALU(writer, op) \
+    writer_char(writer, '('); \
+    print_operand(writer, expression, node->params[0]); \
+    writer_printf(writer, " %s ", op); \
+    print_operand(writer, expression, node->params[1]); \
+    writer_char(writer, ')'); \
+    break
+
+// Prints a single node without descending into its operands so rendering a
+// trace stays linear in the size of the expression.
+static void print_node(Writer *writer, const Expression *expression, Uint32 index) {
+  const Node *node = &expression->nodes[index];
+  switch (node->type) {
+  case EXPR_FUNC1:
+    writer_printf(writer, "%s(", func1_name(node->func));
+    print_operand(writer, expression, node->params[0]);
+    writer_char(writer, ')');
+    break;
+  case EXPR_FUNC2:
+    writer_printf(writer, "%s(", func2_name(node->func));
+    print_operand(writer, expression, node->params[0]);
+    writer_string(writer, ", ");
+    print_operand(writer, expression, node->params[1]);
+    writer_char(writer, ')');
+    break;
+  case EXPR_FUNC3:
+    writer_printf(writer, "%s(", func3_name(node->func));
+    print_operand(writer, expression, node->params[0]);
+    writer_string(writer, ", ");
+    print_operand(writer, expression, node->params[1]);
+    writer_string(writer, ", ");
+    print_operand(writer, expression, node->params[2]);
+    writer_char(writer, ')');
+    break;
+  case EXPR_ADD: SHALLOW_ALU(writer, "+");
+  case EXPR_SUB: SHALLOW_ALU(writer, "-");
+  case EXPR_MUL: SHALLOW_ALU(writer, "*");
+  case EXPR_DIV: SHALLOW_ALU(writer, "/");
+  default:
+    print(writer, expression, index);
+    break;
+  }
+}
+
+static const char *OPERATIONS[] = {
+  "ADD",   // OPERATION_ADD
+  "SUB",   // OPERATION_SUB
+  "MUL",   // OPERATION_MUL
+  "DIV",   // OPERATION_DIV
+  "FMA",   // OPERATION_FMA
+  "FLOOR", // OPERATION_FLOOR
+  "CEIL",  // OPERATION_CEIL
+  "TRUNC", // OPERATION_TRUNC
+  "SQRT"   // OPERATION_SQRT
+};
 
-  for (Size i = 0; i < n_exceptions; i++) {
-    Exception exception = ctx->exceptions[i];
-    fprintf(stderr, "Exception: %zu (%zu roundings) ", i, ctx->roundings);
-    Bool flag = false;
-    if (exception & EXCEPTION_INVALID) {
-      fprintf(stderr, "%sINVALID", flag ? "|" : ""), flag = true;
+static void trace_text(Writer *writer, const Expression *expression, const Trace *trace) {
+  // The events of a node are recorded together, render them as one group.
+  const Size n_events = array_size(trace->events);
+  for (Size i = 0; i < n_events; ) {
+    const Uint32 node = trace->events[i].node;
+    writer_printf(writer, "#%u = ", node);
+    print_node(writer, expression, node);
+    writer_char(writer, '\n');
+    Bool hit = false;
+    for (; i < n_events && trace->events[i].node == node; i++) {
+      const Event *event = &trace->events[i];
+      if (event->kind == EVENT_EXCEPTION) {
+        writer_printf(writer, "%s  Exception: %u ", hit ? "\n" : "", event->index);
+        writer_exceptions(writer, event->value);
+        writer_char(writer, '\n');
+        hit = false;
+      } else {
+        writer_printf(writer, "%s%s", hit ? " " : "  Trace: ", OPERATIONS[event->value]);
+        hit = true;
+      }
     }
-    if (exception & EXCEPTION_INFINITE) {
-      fprintf(stderr, "%sINFINITE", flag ? "|" : ""), flag = true;
+    if (hit) {
+      writer_char(writer, '\n');
+    }
+  }
+}
+
+// One "node\tkind\tindex\tvalue" record per event.
+static void trace_tsv(Writer *writer, const Trace *trace) {
+  for (Size i = 0; i < array_size(trace->events); i++) {
+    const Event *event = &trace->events[i];
+    if (event->kind == EVENT_EXCEPTION) {
+      writer_printf(writer, "%u\texception\t%u\t", event->node, event->index);
+      writer_exceptions(writer, event->value);
+    } else {
+      writer_printf(writer, "%u\toperation\t%u\t%s", event->node, event->index, OPERATIONS[event->value]);
     }
-    if (exception & EXCEPTION_OVERFLOW) {
-      fprintf(stderr, "%sOVERFLOW", flag ? "|" : ""), flag = true;
+    writer_char(writer, '\n');
+  }
+}
+
+static void trace_json(Writer *writer, const Expression *expression, const Trace *trace) {
+  for (Size i = 0; i < array_size(trace->events); i++) {
+    const Event *event = &trace->events[i];
+    writer_printf(writer, "{\"node\":%u,\"index\":%u,", event->node, event->index);
+    if (event->kind == EVENT_EXCEPTION) {
+      writer_string(writer, "\"exception\":\"");
+      writer_exceptions(writer, event->value);
+      writer_char(writer, '"');
+    } else {
+      writer_printf(writer, "\"operation\":\"%s\"", OPERATIONS[event->value]);
     }
-    if (exception & EXCEPTION_UNDERFLOW) {
-      fprintf(stderr, "%sUNDERFLOW", flag ? "|" : ""), flag = true;
+    // The node is only spelled out with its first event.
+    if (i == 0 || trace->events[i - 1].node != event->node) {
+      writer_string(writer, ",\"expression\":\"");
+      print_node(writer, expression, event->node);
+      writer_char(writer, '"');
     }
-    if (exception & EXCEPTION_INEXACT) {
-      fprintf(stderr, "%sINEXACT", flag ? "|" : ""), flag = true;
+    writer_string(writer, "}\n");
+  }
+}
+
+void expr_trace(Writer *writer, const Expression *expression, const Trace *trace) {
+  switch (writer->format) {
+  case FORMAT_TEXT:
+    trace_text(writer, expression, trace);
+    break;
+  case FORMAT_TSV:
+    trace_tsv(writer, trace);
+    break;
+  case FORMAT_JSON:
+    trace_json(writer, expression, trace);
+    break;
+  }
+}
+
+// Spans are named after their node, as "#N" followed by the node itself.
+static void print_span(Writer *writer, const Expression *expression, const Span *span) {
+  writer_printf(writer, "#%u ", span->node);
+  print_node(writer, expression, span->node);
+}
+
+// Complete events on a single thread, with timestamps in microseconds since
+// the first span began.
+void expr_profile_chrome(Writer *writer, const Expression *expression, const Trace *trace) {
+  const Size n_spans = array_size(trace->spans);
+  const Uint64 origin = n_spans ? trace->spans[0].begin : 0;
+  writer_string(writer, "{\"traceEvents\":[");
+  for (Size i = 0; i < n_spans; i++) {
+    const Span *span = &trace->spans[i];
+    writer_string(writer, i ? ",{\"name\":\"" : "{\"name\":\"");
+    print_span(writer, expression, span);
+    writer_printf(writer, "\",\"cat\":\"node\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,\"args\":{\"node\":%u}}",
+      (span->begin - origin) / 1e3, (span->end - span->begin) / 1e3, span->node);
+  }
+  writer_string(writer, "],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+static void print_stack(Writer *writer, const Expression *expression, const Trace *trace, Uint32 span) {
+  const Span *s = &trace->spans[span];
+  if (s->parent != TRACE_ROOT) {
+    print_stack(writer, expression, trace, s->parent);
+    writer_char(writer, ';');
+  }
+  print_span(writer, expression, s);
+}
+
+// A "root;...;node nanoseconds" line per span, where the time is what the node
+// took less its operands.
+void expr_profile_folded(Writer *writer, const Expression *expression, const Trace *trace) {
+  const Size n_spans = array_size(trace->spans);
+  Uint64 *operands = calloc(n_spans ? n_spans : 1, sizeof *operands);
+  if (!operands) {
+    return;
+  }
+  for (Size i = 0; i < n_spans; i++) {
+    const Span *span = &trace->spans[i];
+    if (span->parent != TRACE_ROOT) {
+      operands[span->parent] += span->end - span->begin;
     }
-    fprintf(stderr, " ");
-    expr_print(stderr, expression);
-    fprintf(stderr, "\n");
   }
-  if (n_operations && n_exceptions) {
-    fprintf(stderr, "  Trace (%zu operations) ", n_operations);
-    Bool hit = false;
-    for (Size i = 0; i < n_operations; i++) {
-      Operation operation = ctx->operations[i];
-      switch (operation) {
-      case OPERATION_ADD: fprintf(stderr, "%sADD", hit ? " " : ""), hit = true; break;
-      case OPERATION_SUB: fprintf(stderr, "%sSUB", hit ? " " : ""), hit = true; break;
-      case OPERATION_MUL: fprintf(stderr, "%sMUL", hit ? " " : ""), hit = true; break;
-      case OPERATION_DIV: fprintf(stderr, "%sDIV", hit ? " " : ""), hit = true; break;
-      }
+  for (Size i = 0; i < n_spans; i++) {
+    const Span *span = &trace->spans[i];
+    print_stack(writer, expression, trace, i);
+    writer_printf(writer, " %llu\n", (unsigned long long)(span->end - span->begin - operands[i]));
+  }
+  free(operands);
+}
+
+static Bool compile_node(Program*, const Expression*, Uint32*, Uint32, Uint32*);
+
+// Opcodes of FUNC_* in order of declaration.
+static const Opcode FUNC_OPCODES[] = {
+  OP_FLOOR, OP_CEIL, OP_TRUNC, OP_SQRT, OP_ABS,
+  OP_MIN, OP_MAX, OP_COPYSIGN,
+  OP_FMA
+};
+
+// When the expression has shared nodes [registers] maps nodes to the register
+// they were already compiled into, so each is only evaluated once.
+static Bool compile(Program *program, const Expression *expression, Uint32 *registers, Uint32 index, Uint32 *r) {
+  if (registers && registers[index] != LIT32(0xffffffff)) {
+    *r = registers[index];
+    return true;
+  }
+  if (registers) {
+    if (!compile_node(program, expression, registers, index, &registers[index])) {
+      return false;
     }
-    fprintf(stderr, "\n");
-    fprintf(stderr, "\n");
+    *r = registers[index];
+    return true;
   }
+  return compile_node(program, expression, registers, index, r);
+}
 
-  return result;
+static Bool compile_node(Program *program, const Expression *expression, Uint32 *registers, Uint32 index, Uint32 *r) {
+  const Node *node = &expression->nodes[index];
+  Uint32 a = 0;
+  Uint32 b = 0;
+  Uint32 c = 0;
+  if (node->params[0] && !compile(program, expression, registers, node->params[0], &a)) {
+    return false;
+  }
+  if (node->params[1] && !compile(program, expression, registers, node->params[1], &b)) {
+    return false;
+  }
+  if (node->params[2] && !compile(program, expression, registers, node->params[2], &c)) {
+    return false;
+  }
+
+  Opcode op = OP_LAST;
+  switch (node->type) {
+  /****/ case EXPR_VALUE: return program_load(program, index, node->value, node->raised, r);
+  /****/ case EXPR_CONST: return program_load(program, index, CONSTANTS[node->constant].value, 0, r);
+  /****/ case EXPR_VAR:   return program_emit(program, index, OP_VAR, node->variable, 0, 0, r);
+  /****/ case EXPR_FUNC1: // fallthrough
+  /****/ case EXPR_FUNC2: // fallthrough
+  /****/ case EXPR_FUNC3: op = FUNC_OPCODES[node->func];
+  break; case EXPR_EQ:    op = OP_EQ;
+  break; case EXPR_LTE:   op = OP_LTE;
+  break; case EXPR_LT:    op = OP_LT;
+  break; case EXPR_NE:    op = OP_NE;
+  break; case EXPR_GTE:   op = OP_GTE;
+  break; case EXPR_GT:    op = OP_GT;
+  break; case EXPR_ADD:   op = OP_ADD;
+  break; case EXPR_SUB:   op = OP_SUB;
+  break; case EXPR_MUL:   op = OP_MUL;
+  break; case EXPR_DIV:   op = OP_DIV;
+  break; case EXPR_LAST:  op = OP_LAST;
+  break;
+  }
+
+  return program_emit(program, index, op, a, b, c, r);
 }
 
-static Expression *create(int type, Expression *e0, Expression *e1) {
-  Expression *e = calloc(1, sizeof *e);
-  if (!e) {
-    return NULL;
+Bool expr_compile(Program *program, Expression *expression) {
+  Uint32 r;
+  program_init(program);
+  program->inputs = expression->n_variables;
+  Uint32 *registers = NULL;
+  if (expression->shared) {
+    registers = malloc(expression->size * sizeof *registers);
+    if (!registers) {
+      return false;
+    }
+    for (Size i = 0; i < expression->size; i++) {
+      registers[i] = LIT32(0xffffffff);
+    }
   }
-  e->type = type;
-  e->value = REAL32_ONE;
-  e->params[0] = e0;
-  e->params[1] = e1;
-  return e;
+  const Bool ok = compile(program, expression, registers, expression->root, &r);
+  free(registers);
+  if (!ok) {
+    program_free(program);
+    return false;
+  }
+  return true;
 }
 
-static Bool parse_expr(Expression **e, Parser *p);
-static Bool parse_primary(Expression **e, Parser *p, Flag sign) {
-  Expression *d = calloc(1, sizeof *d);
-  if (!d) {
+// Find or add the variable [name] of [length] characters.
+static Bool variable_intern(Expression *e, const char *name, Size length, Uint32 *variable) {
+  for (Uint32 i = 0; i < e->n_variables; i++) {
+    if (!strncmp(e->variables[i].name, name, length) && !e->variables[i].name[length]) {
+      *variable = i;
+      return true;
+    }
+  }
+  if (e->n_variables == EXPR_MAX_VARIABLES || length > EXPR_VARIABLE_LENGTH) {
     return false;
   }
+  Variable *v = &e->variables[e->n_variables];
+  memcpy(v->name, name, length);
+  v->name[length] = '\0';
+  v->value = REAL32_ZERO;
+  *variable = e->n_variables++;
+  return true;
+}
 
+static Uint32 node_hash(const Node *node) {
+  Uint32 hash = LIT32(2166136261);
+  const Uint32 fields[] = {
+    node->type, node->func, node->params[0], node->params[1], node->params[2],
+    node->value.value.bits, node->value.eps.bits
+  };
+  for (Size i = 0; i < ARRAY_COUNT(fields); i++) {
+    hash = (hash ^ fields[i]) * LIT32(16777619);
+  }
+  return hash;
+}
+
+static Bool node_equal(const Node *a, const Node *b) {
+  return a->type == b->type
+      && a->func == b->func
+      && a->params[0] == b->params[0]
+      && a->params[1] == b->params[1]
+      && a->params[2] == b->params[2]
+      && a->value.value.bits == b->value.value.bits
+      && a->value.eps.bits == b->value.eps.bits;
+}
+
+// Hash-cons [node], returning the index of an existing identical node when
+// there is one. Parameters are interned before their parents, so comparing
+// parameter indices compares whole subexpressions.
+//
+// The node pool is sized up front from the input so this cannot fail.
+static Uint32 intern(Parser *p, const Node *node) {
+  Expression *e = p->e;
+  Uint32 slot = node_hash(node) & p->mask;
+  for (; p->table[slot]; slot = (slot + 1) & p->mask) {
+    if (node_equal(&e->nodes[p->table[slot]], node)) {
+      e->shared++;
+      return p->table[slot];
+    }
+  }
+  const Uint32 index = e->size++;
+  e->nodes[index] = *node;
+  p->table[slot] = index;
+  return index;
+}
+
+// Literals are shared by their text rather than by their value, so the nodes
+// come out the same whatever mode they are rounded in, see expr_parse.
+static Uint32 intern_literal(Parser *p, const Node *node, const char *text, Size length) {
+  Expression *e = p->e;
+  Uint32 hash = LIT32(2166136261);
+  for (Size i = 0; i < length; i++) {
+    hash = (hash ^ (Uint8)text[i]) * LIT32(16777619);
+  }
+  Uint32 slot = hash & p->mask;
+  for (; p->table[slot]; slot = (slot + 1) & p->mask) {
+    const Uint32 index = p->table[slot];
+    const Literal *literal = &p->literals[index];
+    if (e->nodes[index].type == EXPR_VALUE && literal->length == length && !memcmp(p->input + literal->offset, text, length)) {
+      e->shared++;
+      return index;
+    }
+  }
+  const Uint32 index = e->size++;
+  e->nodes[index] = *node;
+  p->literals[index] = (Literal){ text - p->input, length };
+  p->table[slot] = index;
+  return index;
+}
+
+static Uint32 create(Parser *p, int type, Uint32 e0, Uint32 e1) {
+  const Node node = { .type = type, .params = { e0, e1 }, .value = REAL32_ONE };
+  return intern(p, &node);
+}
+
+static Bool parse_expr(Uint32 *e, Parser *p);
+static Bool parse_primary(Uint32 *e, Parser *p, Flag sign) {
   char *next = p->s;
   char *s0 = p->s;
-  d->value = real32_from_string(sign ? p->s - 1 : p->s, &next);
-  if (next != p->s) {
-    d->type = EXPR_VALUE;
+  const char *text = sign ? p->s - 1 : p->s;
+  const Real32 value = real32_from_string(&p->ctx, text, &next);
+  // Like constants, inf and nan only count when they are not the start of a
+  // longer identifier, which is then a variable.
+  const Bool named = is_identifier(*p->s) && (unsigned)*p->s - '0' > 9u;
+  if (next != p->s && !(named && is_identifier(*next))) {
+    const Node node = { .type = EXPR_VALUE, .raised = p->ctx.raised, .value = value };
     p->s = next;
-    *e = d;
+    *e = intern_literal(p, &node, text, next - text);
     return true;
   }
 
-  d->value = REAL32_ONE;
-
   for (Size i = 0; i < sizeof CONSTANTS / sizeof *CONSTANTS; i++) {
     if (!match(p->s, CONSTANTS[i].identifier)) {
       continue;
     }
     p->s += strlen(CONSTANTS[i].identifier);
-    d->type = EXPR_CONST;
-    d->constant = i;
-    *e = d;
+    const Node node = { .type = EXPR_CONST, .constant = i, .value = REAL32_ONE };
+    *e = intern(p, &node);
     return true;
   }
 
+  // An identifier not followed by '(' names a variable.
+  if (is_identifier(*p->s) && (unsigned)*p->s - '0' > 9u) {
+    Size length = 0;
+    while (is_identifier(p->s[length])) {
+      length++;
+    }
+    if (p->s[length] != '(') {
+      Uint32 variable;
+      if (!variable_intern(p->e, p->s, length, &variable)) {
+        fprintf(stderr, "Too many variables or variable name too long in '%s'\n", s0);
+        return false;
+      }
+      p->s += length;
+      const Node node = { .type = EXPR_VAR, .variable = variable, .value = REAL32_ONE };
+      *e = intern(p, &node);
+      return true;
+    }
+  }
+
   p->s = strchr(p->s, '(');
   if (!p->s) {
     fprintf(stderr, "Undefined constant or missing '(' in '%s'\n", s0);
     p->s = next;
-    expr_free(d);
     return false;
   }
 
   p->s++; // '('
   if (*next == '(') {
-    expr_free(d);
+    Uint32 d;
     if (!parse_expr(&d, p)) {
       return false;
     }
     if (*p->s != ')') {
       fprintf(stderr, "Missing ')' in '%s'\n", s0);
-      expr_free(d);
       return false;
     }
     p->s++; // ')'
     *e = d;
     return true;
   }
-  if (!parse_expr(&d->params[0], p)) {
-    expr_free(d);
+  Uint32 params[3] = { 0, 0, 0 };
+  if (!parse_expr(&params[0], p)) {
     return false;
   }
   if (*p->s == ',') {
     p->s++; // ','
-    parse_expr(&d->params[1], p); // ignore?
+    parse_expr(&params[1], p); // ignore?
+  }
+  if (*p->s == ',') {
+    p->s++; // ','
+    parse_expr(&params[2], p); // ignore?
   }
   if (*p->s != ')') {
     fprintf(stderr, "Missing ')' or too many arguments in '%s'\n", s0);
-    expr_free(d);
     return false;
   }
   p->s++; // ')'
 
   for (Size i = 0; i < ARRAY_COUNT(FUNCS1); i++) {
     if (match(next, FUNCS1[i].match)) {
-      d->type = EXPR_FUNC1;
-      d->func = FUNCS1[i].func;
-      *e = d;
+      const Node node = {
+        .type = EXPR_FUNC1,
+        .func = FUNCS1[i].func,
+        .params = { params[0], params[1], params[2] },
+        .value = REAL32_ONE
+      };
+      *e = intern(p, &node);
       return true;
     }
   }
 
   for (Size i = 0; i < ARRAY_COUNT(FUNCS2); i++) {
     if (match(next, FUNCS2[i].match)) {
-      d->type = EXPR_FUNC2;
-      d->func = FUNCS2[i].func;
-      *e = d;
+      const Node node = {
+        .type = EXPR_FUNC2,
+        .func = FUNCS2[i].func,
+        .params = { params[0], params[1], params[2] },
+        .value = REAL32_ONE
+      };
+      *e = intern(p, &node);
       return true;
     }
   }
 
-  fprintf(stderr, "Unknown identifier '%s'", s0);
-  expr_free(d);
+  for (Size i = 0; i < ARRAY_COUNT(FUNCS3); i++) {
+    if (match(next, FUNCS3[i].match)) {
+      const Node node = {
+        .type = EXPR_FUNC3,
+        .func = FUNCS3[i].func,
+        .params = { params[0], params[1], params[2] },
+        .value = REAL32_ONE
+      };
+      *e = intern(p, &node);
+      return true;
+    }
+  }
 
-  return true;
+  fprintf(stderr, "Unknown identifier '%s'\n", s0);
+
+  return false;
 }
 
-static Bool parse_top(Expression **e, Parser *p) {
+static Bool parse_top(Uint32 *e, Parser *p) {
   Flag sign = false;
   if (*p->s == '+') p->s++; // skip unary '+'
   else if (*p->s == '-') p->s++, sign = true; // skip unary '-'
   return parse_primary(e, p, sign);
 }
 
-static Bool parse_factor(Expression **e, Parser *p) {
-  Expression *e0;
+static Bool parse_factor(Uint32 *e, Parser *p) {
+  Uint32 e0;
   if (!parse_top(&e0, p)) {
     return false;
   }
@@ -376,8 +1019,8 @@ static Bool parse_factor(Expression **e, Parser *p) {
   return true;
 }
 
-static Bool parse_term(Expression **e, Parser *p) {
-  Expression *e0, *e1, *e2;
+static Bool parse_term(Uint32 *e, Parser *p) {
+  Uint32 e0, e1, e2;
   if (!parse_factor(&e0, p)) {
     return false;
   }
@@ -385,22 +1028,16 @@ static Bool parse_term(Expression **e, Parser *p) {
     int ch = *p->s++;
     e1 = e0;
     if (!parse_factor(&e2, p)) {
-      expr_free(e1);
-      return false;
-    }
-    e0 = create(ch == '*' ? EXPR_MUL : EXPR_DIV, e1, e2);
-    if (!e0) {
-      expr_free(e1);
-      expr_free(e2);
       return false;
     }
+    e0 = create(p, ch == '*' ? EXPR_MUL : EXPR_DIV, e1, e2);
   }
   *e = e0;
   return true;
 }
 
-static Bool parse_subexpr(Expression **e, Parser *p) {
-  Expression *e0, *e1, *e2;
+static Bool parse_subexpr(Uint32 *e, Parser *p) {
+  Uint32 e0, e1, e2;
   if (!parse_term(&e0, p)) {
     return false;
   }
@@ -408,22 +1045,16 @@ static Bool parse_subexpr(Expression **e, Parser *p) {
     int ch = *p->s++;
     e1 = e0;
     if (!parse_term(&e2, p)) {
-      expr_free(e1);
-      return false;
-    }
-    e0 = create(ch == '+' ? EXPR_ADD : EXPR_SUB, e1, e2);
-    if (!e0) {
-      expr_free(e1);
-      expr_free(e2);
       return false;
     }
+    e0 = create(p, ch == '+' ? EXPR_ADD : EXPR_SUB, e1, e2);
   }
   *e = e0;
   return true;
 }
 
-static Bool parse_expr(Expression **e, Parser *p) {
-  Expression *e0, *e1, *e2;
+static Bool parse_expr(Uint32 *e, Parser *p) {
+  Uint32 e0, e1, e2;
   if (!parse_subexpr(&e0, p)) {
     return false;
   }
@@ -431,45 +1062,80 @@ static Bool parse_expr(Expression **e, Parser *p) {
     p->s++;
     e1 = e0;
     if (!parse_subexpr(&e2, p)) {
-      expr_free(e1);
-      return false;
-    }
-    e0 = create(EXPR_LAST, e1, e2);
-    if (!e0) {
-      expr_free(e1);
-      expr_free(e2);
       return false;
     }
+    e0 = create(p, EXPR_LAST, e1, e2);
   }
   *e = e0;
   return true;
 }
 
-static Bool parse_verify(Expression *expression) {
-  if (!expression) {
+static Bool parse_verify(const Expression *expression, Uint32 index) {
+  if (!index) {
     return false;
   }
-  switch (expression->type) {
+  const Node *node = &expression->nodes[index];
+  switch (node->type) {
   case EXPR_VALUE: // fallthrough
-  case EXPR_CONST:
+  case EXPR_CONST: // fallthrough
+  case EXPR_VAR:
     return true;
   case EXPR_FUNC1:
-    return parse_verify(expression->params[0]) && !expression->params[1];
+    return parse_verify(expression, node->params[0])
+        && !node->params[1] && !node->params[2];
+  case EXPR_FUNC3:
+    return parse_verify(expression, node->params[0])
+        && parse_verify(expression, node->params[1])
+        && parse_verify(expression, node->params[2]);
   default:
-    return parse_verify(expression->params[0]) && parse_verify(expression->params[1]);
+    return parse_verify(expression, node->params[0])
+        && parse_verify(expression, node->params[1])
+        && !node->params[2];
   }
 }
 
-Bool expr_parse(Expression **expression, const char *string) {
+Bool expr_parse(Expression **expression, const Context *ctx, const char *string) {
   Parser p = { 0 };
-  char *w = malloc(strlen(string) + 1);
-  char *wp = w;
+  const Size length = strlen(string);
   const char *s0 = string;
 
-  if (!w) {
+  // Every node consumes at least one non-space character of the input, which
+  // bounds the size of the node pool. The hash table used to share identical
+  // nodes, the text of literals and the whitespace-stripped copy of the input
+  // are placed after the pool and dropped once parsing is done.
+  //
+  // Which nodes are shared does not depend on the modes of the context, so
+  // parsing the same input in any of them gives the same nodes, which only
+  // differ in the values and flags of their literals.
+  const Size capacity = length + 1;
+  Size slots = 1;
+  while (slots < 2 * capacity) {
+    slots <<= 1;
+  }
+  Expression *e = malloc(sizeof *e
+                       + capacity * sizeof *e->nodes
+                       + slots * sizeof *p.table
+                       + capacity * sizeof *p.literals
+                       + length + 1);
+  if (!e) {
     return false;
   }
+  context_copy(&p.ctx, ctx);
+  e->root = 0;
+  e->size = 1; // Index 0 is reserved.
+  e->shared = 0;
+  e->evaluation = 0;
+  e->memo = NULL;
+  e->n_variables = 0;
+
+  p.table = (Uint32 *)&e->nodes[capacity];
+  p.mask = slots - 1;
+  memset(p.table, 0, slots * sizeof *p.table);
 
+  p.literals = (Literal *)&p.table[slots];
+
+  char *w = (char *)&p.literals[capacity];
+  char *wp = w;
   while (*string) {
     if (*string != ' ') {
       *wp++ = *string;
@@ -479,36 +1145,73 @@ Bool expr_parse(Expression **expression, const char *string) {
   *wp++ = '\0';
 
   p.s = w;
+  p.input = w;
+  p.e = e;
 
-  Expression *e = NULL;
-  if (!parse_expr(&e, &p)) {
-    free(w);
+  const Bool parsed = parse_expr(&e->root, &p);
+  context_free(&p.ctx);
+  if (!parsed) {
+    free(e);
     return false;
   }
 
   if (*p.s) {
-    expr_free(e);
-    free(w);
+    free(e);
     fprintf(stderr, "Unexpected end of expression '%s'\n", s0);
     return false;
   }
 
-  if (!parse_verify(e)) {
-    expr_free(e);
-    free(w);
+  if (!parse_verify(e, e->root)) {
+    free(e);
     return false;
   }
 
-  free(w);
+  if (e->shared) {
+    e->memo = calloc(e->size, sizeof *e->memo);
+    if (!e->memo) {
+      free(e);
+      return false;
+    }
+  }
 
-  *expression = e;
+  // Release the unused part of the pool along with the stripped input.
+  Expression *shrunk = realloc(e, sizeof *e + e->size * sizeof *e->nodes);
+  *expression = shrunk ? shrunk : e;
   return true;
 }
 
 void expr_free(Expression *expression) {
-  if (expression) {
-    expr_free(expression->params[0]);
-    expr_free(expression->params[1]);
-    free(expression);
+  free(expression->memo);
+  free(expression);
+}
+
+Size expr_variables(const Expression *expression) {
+  return expression->n_variables;
+}
+
+const char *expr_variable(const Expression *expression, Size index) {
+  return expression->variables[index].name;
+}
+
+Bool expr_find_variable(const Expression *expression, const char *name, Size *index) {
+  for (Size i = 0; i < expression->n_variables; i++) {
+    if (!strcmp(expression->variables[i].name, name)) {
+      *index = i;
+      return true;
+    }
   }
-}
\ No newline at end of file
+  return false;
+}
+
+void expr_bind(Expression *expression, Size index, Real32 value) {
+  expression->variables[index].value = value;
+}
+
+Bool expr_parse_value(const Context *ctx, const char *string, Real32 *value) {
+  Context scratch = { 0 };
+  context_copy(&scratch, ctx);
+  char *next = NULL;
+  *value = real32_from_string(&scratch, string, &next);
+  context_free(&scratch);
+  return next != string && !*next;
+}
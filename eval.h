@@ -1,12 +1,91 @@
 #ifndef EVAL_H
 #define EVAL_H
-#include "real32.h"
+#include "program.h"
+#include "writer.h"
 
 typedef struct Expression Expression;
+typedef struct Event Event;
+typedef struct Span Span;
+typedef struct Trace Trace;
 
-Bool expr_parse(Expression**, const char*);
-Real32 expr_eval32(Context*, Expression*);
+#define EXPR_MAX_VARIABLES 8
+#define EXPR_VARIABLE_LENGTH 15
+
+// A record of the context made by a single node, see Record.
+struct Event {
+  Uint32 node;
+  Uint32 index;
+  Uint8 kind;
+  Uint8 value; ///< Exception flags or Operation.
+};
+
+// The time a node took to evaluate including its operands, in nanoseconds of
+// the monotonic clock. [parent] is the span of the node that used it, or
+// TRACE_ROOT for the root.
+struct Span {
+  Uint32 node;
+  Uint32 parent;
+  Uint64 begin;
+  Uint64 end;
+};
+
+#define TRACE_ROOT LIT32(0xffffffff)
+
+// Events recorded by expr_eval32 in order of evaluation, and spans in the order
+// nodes were entered when [timed] is set, which costs a branch per node when
+// it is not. Leaves are never timed.
+struct Trace {
+  ARRAY(Event) events;
+  ARRAY(Span) spans;
+  Bool timed;
+  Uint32 open; ///< Span being evaluated.
+};
+
+void trace_init(Trace*);
+void trace_free(Trace*);
+
+// Parse an expression, literals are rounded in the rounding and tininess modes
+// of the context but nothing is recorded in it. An inexact literal carries the
+// error of its rounding, and what rounding it raised is raised again, without
+// trapping, whenever it is evaluated.
+Bool expr_parse(Expression**, const Context*, const char*);
 void expr_free(Expression*);
-void expr_print(FILE*, Expression*);
+void expr_print(Writer*, const Expression*);
+
+// Evaluate an expression, recording what each node raised and did into
+// [trace] unless it is NULL, in which case evaluation does no I/O at all.
+// Traces are built from the records of the context, so only hold what its
+// ring still had when each node finished.
+//
+// A trap handler that aborts stops the evaluation right away, leaving [aborted]
+// set in the context and returning NaN. What was done until then stays counted
+// in the context, but the node that trapped records nothing in [trace]. Nodes
+// evaluated once for all their uses trap once.
+Real32 expr_eval32(Context*, Expression*, Trace*);
+
+// Render a trace as the exceptions and operations of each node in turn, in
+// the format of [writer].
+void expr_trace(Writer*, const Expression*, const Trace*);
+
+// Render the spans of a trace as a Chrome trace event JSON object on a line,
+// or as folded stacks with the time of each node less its operands, for
+// flame graph tools.
+void expr_profile_chrome(Writer*, const Expression*, const Trace*);
+void expr_profile_folded(Writer*, const Expression*, const Trace*);
+
+// Free variables of an expression, in order of first appearance.
+Size expr_variables(const Expression*);
+const char *expr_variable(const Expression*, Size index);
+Bool expr_find_variable(const Expression*, const char *name, Size *index);
+
+// Bind the value used for a variable by expr_eval32, unbound variables are 0.
+void expr_bind(Expression*, Size index, Real32 value);
+
+// Parse a single literal value the same way literals in expressions are.
+Bool expr_parse_value(const Context*, const char*, Real32*);
+
+// Lower an expression into a flat program for repeated evaluation, variable
+// number i of the expression becomes input i of the program.
+Bool expr_compile(Program*, Expression*);
 
 #endif // EVAL_H
\ No newline at end of file
@@ -0,0 +1,588 @@
+#include "float128.h"
+#include "float32.h"
+#include "float64.h"
+
+// The implicit bit of a significant and the leading bit of the significants
+// passed to round_and_pack.
+#define BIT112 ((Uint128){LIT64(0x0001000000000000), 0})
+#define BIT125 ((Uint128){LIT64(0x2000000000000000), 0})
+#define BIT126 ((Uint128){LIT64(0x4000000000000000), 0})
+
+static inline Flag is_zero(Uint128 a) {
+  return (a.z0 | a.z1) == 0;
+}
+
+// Take two quadruple-precision float values, one which must be NaN, and produce
+// the correct NaN result, taking care to raise an invalid exception when either
+// is a signaling NaN.
+static Float128 float128_propagate_nan(Context *ctx, Float128 a, Float128 b) {
+  const Flag a_is_nan = float128_is_nan(a);
+  const Flag a_is_snan = float128_is_snan(a);
+  const Flag b_is_nan = float128_is_nan(b);
+  const Flag b_is_snan = float128_is_snan(b);
+  a.bits.z0 |= LIT64(0x0000800000000000);
+  b.bits.z0 |= LIT64(0x0000800000000000);
+  if (a_is_snan | b_is_snan) {
+    context_raise(ctx, EXCEPTION_INVALID);
+  }
+  if (a_is_nan) {
+    return (a_is_snan & b_is_nan) ? b : a;
+  }
+  return b;
+}
+
+CanonicalNaN float128_to_canonical_nan(Context *ctx, Float128 a) {
+  if (float128_is_snan(a)) {
+    context_raise(ctx, EXCEPTION_INVALID);
+  }
+  CanonicalNaN nan;
+  nan.sign = a.bits.z0 >> 63;
+  nan.hi = (a.bits.z0 << 16) | (a.bits.z1 >> 48);
+  nan.lo = a.bits.z1 << 16;
+  return nan;
+}
+
+static Float128 canonical_nan_to_float128(CanonicalNaN nan) {
+  const Uint64 z0 = (((Uint64)nan.sign) << 63) | LIT64(0x7FFF800000000000) | (nan.hi >> 16);
+  return (Float128){{z0, (nan.hi << 48) | (nan.lo >> 16)}};
+}
+
+Float128 float128_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint128 sig) {
+  const Round rounding_mode = ctx->config.round;
+  const Flag round_nearest_even = rounding_mode == ROUND_NEAREST_EVEN;
+  Uint64 round_increment = 0x2000;
+  if (!round_nearest_even) {
+    if (rounding_mode == ROUND_TO_ZERO) {
+      round_increment = 0;
+    } else {
+      round_increment = 0x3fff;
+      if (sign) {
+        if (rounding_mode == ROUND_UP) {
+          round_increment = 0;
+        }
+      } else {
+        if (rounding_mode == ROUND_DOWN) {
+          round_increment = 0;
+        }
+      }
+    }
+  }
+
+  Uint64 round_bits = sig.z1 & 0x3fff;
+
+  if (round_bits) {
+    ctx->roundings++;
+  }
+
+  if (0x7ffd <= (Uint32)exp) {
+    const Uint128 rounded = uint128_add(sig, (Uint128){0, round_increment});
+    if ((0x7ffd < exp) || ((exp == 0x7ffd) && ((Sint64)rounded.z0 < 0))) {
+      context_raise(ctx, EXCEPTION_OVERFLOW | EXCEPTION_INEXACT);
+      const Float128 pack = float128_pack(sign, 0x7fff, (Uint128){0, 0});
+      return round_increment == 0
+        ? (Float128){uint128_sub(pack.bits, (Uint128){0, 1})}
+        : pack;
+    }
+    if (exp < 0) {
+      const Flag is_tiny = (ctx->config.tininess == TININESS_BEFORE_ROUNDING)
+        || (exp < -1)
+        || (Sint64)rounded.z0 >= 0;
+      sig = uint128_rshr(sig, -exp < 128 ? -exp : 128);
+      exp = 0;
+      round_bits = sig.z1 & 0x3fff;
+      if (is_tiny && round_bits) {
+        context_raise(ctx, EXCEPTION_UNDERFLOW);
+      }
+    }
+  }
+  if (round_bits) {
+    context_raise(ctx, EXCEPTION_INEXACT);
+  }
+  sig = uint128_shr(uint128_add(sig, (Uint128){0, round_increment}), 14);
+  sig.z1 &= ~(Uint64)(((round_bits ^ 0x2000) == 0) & round_nearest_even);
+  return float128_pack(sign, is_zero(sig) ? 0 : exp, sig);
+}
+
+static Float128 normalize_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint128 sig) {
+  const Sint16 shift = uint128_clz(sig) - 1;
+  return float128_round_and_pack(ctx, sign, exp - shift, uint128_shl(sig, shift));
+}
+
+Normal128 float128_normalize_subnormal(Uint128 sig) {
+  const Sint16 shift = uint128_clz(sig) - 15;
+  return (Normal128){uint128_shl(sig, shift), 1 - shift};
+}
+
+static Float128 add_sig(Context *ctx, Float128 a, Float128 b, Flag sign) {
+  Sint32 a_exp = float128_exp(a);
+  Sint32 b_exp = float128_exp(b);
+  Uint128 a_sig = uint128_shl(float128_fract(a), 13);
+  Uint128 b_sig = uint128_shl(float128_fract(b), 13);
+  Sint32 exp_diff = a_exp - b_exp;
+
+  Sint32 exp;
+  Uint128 sig;
+  if (0 < exp_diff) {
+    if (a_exp == 0x7fff) {
+      return is_zero(a_sig) ? a : float128_propagate_nan(ctx, a, b);
+    }
+    if (b_exp == 0) {
+      exp_diff--;
+    } else {
+      b_sig.z0 |= BIT125.z0;
+    }
+    b_sig = uint128_rshr(b_sig, exp_diff < 128 ? exp_diff : 128);
+    exp = a_exp;
+  } else if (exp_diff < 0) {
+    if (b_exp == 0x7fff) {
+      return is_zero(b_sig)
+        ? float128_pack(sign, 0x7fff, (Uint128){0, 0})
+        : float128_propagate_nan(ctx, a, b);
+    }
+    if (a_exp == 0) {
+      exp_diff++;
+    } else {
+      a_sig.z0 |= BIT125.z0;
+    }
+    a_sig = uint128_rshr(a_sig, -exp_diff < 128 ? -exp_diff : 128);
+    exp = b_exp;
+  } else {
+    if (a_exp == 0x7fff) {
+      return is_zero(a_sig) && is_zero(b_sig) ? a : float128_propagate_nan(ctx, a, b);
+    }
+    if (a_exp == 0) {
+      return float128_pack(sign, 0, uint128_shr(uint128_add(a_sig, b_sig), 13));
+    }
+    sig = uint128_add(BIT126, uint128_add(a_sig, b_sig));
+    exp = a_exp;
+    goto round_and_pack;
+  }
+  a_sig.z0 |= BIT125.z0;
+  sig = uint128_shl(uint128_add(a_sig, b_sig), 1);
+  exp--;
+  if ((Sint64)sig.z0 < 0) {
+    sig = uint128_add(a_sig, b_sig);
+    exp++;
+  }
+round_and_pack:
+  return float128_round_and_pack(ctx, sign, exp, sig);
+}
+
+static Float128 sub_sig(Context *ctx, Float128 a, Float128 b, Flag sign) {
+  Sint32 a_exp = float128_exp(a);
+  Sint32 b_exp = float128_exp(b);
+  Uint128 a_sig = uint128_shl(float128_fract(a), 14);
+  Uint128 b_sig = uint128_shl(float128_fract(b), 14);
+  Sint32 exp_diff = a_exp - b_exp;
+
+  // Needed because goto crosses initialization.
+  Sint32 exp;
+  Uint128 sig;
+  if (0 < exp_diff) {
+    goto a_exp_bigger;
+  }
+  if (exp_diff < 0) {
+    goto b_exp_bigger;
+  }
+  if (a_exp == 0x7fff) {
+    if (!is_zero(a_sig) || !is_zero(b_sig)) {
+      return float128_propagate_nan(ctx, a, b);
+    }
+    context_raise(ctx, EXCEPTION_INVALID);
+    return FLOAT128_NAN;
+  }
+  if (a_exp == 0) {
+    a_exp = 1;
+    b_exp = 1;
+  }
+  if (uint128_lt(b_sig, a_sig)) {
+    goto a_bigger;
+  }
+  if (uint128_lt(a_sig, b_sig)) {
+    goto b_bigger;
+  }
+  return float128_pack(ctx->config.round == ROUND_DOWN, 0, (Uint128){0, 0});
+b_exp_bigger:
+  if (b_exp == 0x7fff) {
+    return is_zero(b_sig)
+      ? float128_pack(sign ^ 1, 0x7fff, (Uint128){0, 0})
+      : float128_propagate_nan(ctx, a, b);
+  }
+  if (a_exp == 0) {
+    exp_diff++;
+  } else {
+    a_sig.z0 |= BIT126.z0;
+  }
+  a_sig = uint128_rshr(a_sig, -exp_diff < 128 ? -exp_diff : 128);
+  b_sig.z0 |= BIT126.z0;
+b_bigger:
+  sig = uint128_sub(b_sig, a_sig);
+  exp = b_exp;
+  sign ^= 1;
+  goto normalize_round_and_pack;
+a_exp_bigger:
+  if (a_exp == 0x7fff) {
+    return is_zero(a_sig) ? a : float128_propagate_nan(ctx, a, b);
+  }
+  if (b_exp == 0) {
+    exp_diff--;
+  } else {
+    b_sig.z0 |= BIT126.z0;
+  }
+  b_sig = uint128_rshr(b_sig, exp_diff < 128 ? exp_diff : 128);
+  a_sig.z0 |= BIT126.z0;
+a_bigger:
+  sig = uint128_sub(a_sig, b_sig);
+  exp = a_exp;
+normalize_round_and_pack:
+  exp--;
+  return normalize_round_and_pack(ctx, sign, exp, sig);
+}
+
+Float128 float128_add(Context *ctx, Float128 a, Float128 b) {
+  const Flag a_sign = float128_sign(a);
+  const Flag b_sign = float128_sign(b);
+  return a_sign == b_sign
+    ? add_sig(ctx, a, b, a_sign)
+    : sub_sig(ctx, a, b, a_sign);
+}
+
+Float128 float128_sub(Context *ctx, Float128 a, Float128 b) {
+  const Flag a_sign = float128_sign(a);
+  const Flag b_sign = float128_sign(b);
+  return a_sign == b_sign
+    ? sub_sig(ctx, a, b, a_sign)
+    : add_sig(ctx, a, b, a_sign);
+}
+
+// Multiplies two 128-bit integers to obtain the high 128 bits of the product,
+// with the least significant bit set when any of the low 128 bits are.
+static Uint128 mul128x128_jam(Uint128 a, Uint128 b) {
+  const Uint128 hh = uint128_mul64x64(a.z0, b.z0);
+  const Uint128 hl = uint128_mul64x64(a.z0, b.z1);
+  const Uint128 lh = uint128_mul64x64(a.z1, b.z0);
+  const Uint128 ll = uint128_mul64x64(a.z1, b.z1);
+  // The middle column, which may carry into the high 128 bits.
+  const Uint128 mid = uint128_add(hl, (Uint128){0, ll.z0});
+  const Uint128 sum = uint128_add(mid, lh);
+  const Uint64 carry = uint128_lt(sum, lh);
+  Uint128 hi = uint128_add(hh, (Uint128){carry, sum.z0});
+  hi.z1 |= (sum.z1 | ll.z1) != 0;
+  return hi;
+}
+
+Float128 float128_mul(Context *ctx, Float128 a, Float128 b) {
+  Sint32 a_exp = float128_exp(a);
+  Sint32 b_exp = float128_exp(b);
+  Uint128 a_sig = float128_fract(a);
+  Uint128 b_sig = float128_fract(b);
+  Flag sign = float128_sign(a) ^ float128_sign(b);
+  if (a_exp == 0x7fff) {
+    if (!is_zero(a_sig) || (b_exp == 0x7fff && !is_zero(b_sig))) {
+      return float128_propagate_nan(ctx, a, b);
+    }
+    if (b_exp == 0 && is_zero(b_sig)) {
+      context_raise(ctx, EXCEPTION_INVALID);
+      return FLOAT128_NAN;
+    }
+    return float128_pack(sign, 0x7fff, (Uint128){0, 0});
+  }
+  if (b_exp == 0x7fff) {
+    if (!is_zero(b_sig)) {
+      return float128_propagate_nan(ctx, a, b);
+    }
+    if (a_exp == 0 && is_zero(a_sig)) {
+      context_raise(ctx, EXCEPTION_INVALID);
+      return FLOAT128_NAN;
+    }
+    return float128_pack(sign, 0x7fff, (Uint128){0, 0});
+  }
+  if (a_exp == 0) {
+    if (is_zero(a_sig)) {
+      return float128_pack(sign, 0, (Uint128){0, 0});
+    }
+    const Normal128 n = float128_normalize_subnormal(a_sig);
+    a_exp = n.exp;
+    a_sig = n.sig;
+  }
+  if (b_exp == 0) {
+    if (is_zero(b_sig)) {
+      return float128_pack(sign, 0, (Uint128){0, 0});
+    }
+    const Normal128 n = float128_normalize_subnormal(b_sig);
+    b_exp = n.exp;
+    b_sig = n.sig;
+  }
+  Sint32 exp = a_exp + b_exp - 0x3fff;
+  a_sig.z0 |= BIT112.z0;
+  a_sig = uint128_shl(a_sig, 14);
+  b_sig.z0 |= BIT112.z0;
+  b_sig = uint128_shl(b_sig, 15);
+
+  Uint128 sig = mul128x128_jam(a_sig, b_sig);
+  if ((Sint64)(sig.z0 << 1) >= 0) {
+    sig = uint128_shl(sig, 1);
+    exp--;
+  }
+  return float128_round_and_pack(ctx, sign, exp, sig);
+}
+
+// 192-bit integers are z0:z1:z2, most significant first.
+
+// Subtracts [t] from [r], returns the borrow out of the top.
+static Flag sub192(Uint64 r[3], const Uint64 t[3]) {
+  const Uint128 low = uint128_sub((Uint128){r[1], r[2]}, (Uint128){t[1], t[2]});
+  const Uint64 borrow = uint128_lt((Uint128){r[1], r[2]}, (Uint128){t[1], t[2]});
+  const Flag negative = r[0] < t[0] || (r[0] == t[0] && borrow);
+  r[0] = r[0] - t[0] - borrow;
+  r[1] = low.z0;
+  r[2] = low.z1;
+  return negative;
+}
+
+// Adds [t] to [r], returns the carry out of the top.
+static Flag add192(Uint64 r[3], const Uint64 t[3]) {
+  const Uint128 low = uint128_add((Uint128){r[1], r[2]}, (Uint128){t[1], t[2]});
+  const Uint64 carry = uint128_lt(low, (Uint128){t[1], t[2]});
+  const Uint64 top = r[0] + t[0] + carry;
+  const Flag overflow = top < r[0] || (top == r[0] && (t[0] | carry));
+  r[0] = top;
+  r[1] = low.z0;
+  r[2] = low.z1;
+  return overflow;
+}
+
+// One 64-bit digit of the quotient of the 192-bit [r] by the normalized b, where
+// the high 128 bits of [r] are less than b. The estimate from the high word of
+// b is never below the digit and is corrected down, which leaves the remainder
+// in [r].
+static Uint64 div_digit(Uint64 r[3], Uint128 b) {
+  Uint64 q = uint128_div128x64((Uint128){r[0], r[1]}, b.z0);
+  const Uint128 lo = uint128_mul64x64(b.z1, q);
+  const Uint128 hi = uint128_add(uint128_mul64x64(b.z0, q), (Uint128){0, lo.z0});
+  if (sub192(r, (const Uint64[3]){hi.z0, hi.z1, lo.z1})) {
+    do {
+      q--;
+    } while (!add192(r, (const Uint64[3]){0, b.z0, b.z1}));
+  }
+  return q;
+}
+
+// Integer square root of a 64-bit integer, a bit at a time. The bits are as
+// good as random so this is branchless.
+static Uint64 isqrt64(Uint64 x) {
+  Uint64 rem = 0;
+  Uint64 root = 0;
+  for (Sint16 i = 31; i >= 0; i--) {
+    rem = (rem << 2) | ((x >> (2 * i)) & 3);
+    const Uint64 trial = (root << 2) | 1;
+    const Uint64 take = -(Uint64)(rem >= trial);
+    rem -= trial & take;
+    root = (root << 1) | (take & 1);
+  }
+  return root;
+}
+
+Float128 float128_div(Context *ctx, Float128 a, Float128 b) {
+  Sint32 a_exp = float128_exp(a);
+  Sint32 b_exp = float128_exp(b);
+  Uint128 a_sig = float128_fract(a);
+  Uint128 b_sig = float128_fract(b);
+  Flag sign = float128_sign(a) ^ float128_sign(b);
+  if (a_exp == 0x7fff) {
+    if (!is_zero(a_sig)) {
+      return float128_propagate_nan(ctx, a, b);
+    }
+    if (b_exp == 0x7fff) {
+      if (!is_zero(b_sig)) {
+        return float128_propagate_nan(ctx, a, b);
+      }
+      context_raise(ctx, EXCEPTION_INVALID);
+      return FLOAT128_NAN;
+    }
+    return float128_pack(sign, 0x7fff, (Uint128){0, 0});
+  }
+  if (b_exp == 0x7fff) {
+    return is_zero(b_sig)
+      ? float128_pack(sign, 0, (Uint128){0, 0})
+      : float128_propagate_nan(ctx, a, b);
+  }
+  if (b_exp == 0) {
+    if (is_zero(b_sig)) {
+      if (a_exp == 0 && is_zero(a_sig)) {
+        context_raise(ctx, EXCEPTION_INVALID);
+        return FLOAT128_NAN;
+      }
+      context_raise(ctx, EXCEPTION_INFINITE);
+      return float128_pack(sign, 0x7fff, (Uint128){0, 0});
+    }
+    const Normal128 n = float128_normalize_subnormal(b_sig);
+    b_exp = n.exp;
+    b_sig = n.sig;
+  }
+  if (a_exp == 0) {
+    if (is_zero(a_sig)) {
+      return float128_pack(sign, 0, (Uint128){0, 0});
+    }
+    const Normal128 n = float128_normalize_subnormal(a_sig);
+    a_exp = n.exp;
+    a_sig = n.sig;
+  }
+  Sint32 exp = a_exp - b_exp + 0x3ffd;
+  a_sig.z0 |= BIT112.z0;
+  a_sig = uint128_shl(a_sig, 15);
+  b_sig.z0 |= BIT112.z0;
+  b_sig = uint128_shl(b_sig, 15);
+  if (!uint128_lt(a_sig, b_sig)) {
+    a_sig = uint128_shr(a_sig, 1);
+    exp++;
+  }
+
+  // Two 64-bit digits of a * 2^128 / b, which has its leading bit at 127.
+  Uint64 r[3] = { a_sig.z0, a_sig.z1, 0 };
+  const Uint64 q0 = div_digit(r, b_sig);
+  r[0] = r[1];
+  r[1] = r[2];
+  r[2] = 0;
+  const Uint64 q1 = div_digit(r, b_sig);
+  Uint128 sig = uint128_rshr((Uint128){q0, q1}, 1);
+  sig.z1 |= (r[0] | r[1] | r[2]) != 0;
+  return float128_round_and_pack(ctx, sign, exp, sig);
+}
+
+Float128 float128_sqrt(Context *ctx, Float128 a) {
+  Sint32 a_exp = float128_exp(a);
+  Uint128 a_sig = float128_fract(a);
+  const Flag a_sign = float128_sign(a);
+  if (a_exp == 0x7fff) {
+    if (!is_zero(a_sig)) {
+      return float128_propagate_nan(ctx, a, a);
+    }
+    if (!a_sign) {
+      return a;
+    }
+    context_raise(ctx, EXCEPTION_INVALID);
+    return FLOAT128_NAN;
+  }
+  if (a_exp == 0 && is_zero(a_sig)) {
+    return a;
+  }
+  if (a_sign) {
+    context_raise(ctx, EXCEPTION_INVALID);
+    return FLOAT128_NAN;
+  }
+  if (a_exp == 0) {
+    const Normal128 n = float128_normalize_subnormal(a_sig);
+    a_exp = n.exp;
+    a_sig = n.sig;
+  }
+  const Sint32 exp = ((a_exp - 0x3fff) >> 1) + 0x3ffe;
+
+  // The root of x * 2^128 is found as two 64-bit digits, with x the significant
+  // shifted so the exponent is even and the root has its leading bit at 126.
+  // Each digit is estimated from the remainder so far divided by twice the
+  // root so far, which is never below the digit, and corrected down.
+  a_sig.z0 |= BIT112.z0;
+  const Uint128 x = uint128_shl(a_sig, 12 + ((a_exp + 1) & 1));
+
+  // The high digit is the root of x, from the 32-bit root of its high word.
+  const Uint64 s = isqrt64(x.z0);
+  Uint64 z0 = (s << 32) + uint128_div128x64((Uint128){x.z0 - s * s, x.z1}, s << 33);
+  Uint128 square = uint128_mul64x64(z0, z0);
+  while (uint128_lt(x, square)) {
+    z0--;
+    square = uint128_mul64x64(z0, z0);
+  }
+
+  // The low digit from the remainder x * 2^128 - (z0 * 2^64)^2.
+  Uint64 z1 = uint128_div128x64((Uint128){uint128_sub(x, square).z1, 0}, z0 << 1);
+  const Uint128 twice = uint128_mul64x64(z0 << 1, z1);
+  square = uint128_mul64x64(z1, z1);
+  Uint64 r[3] = { uint128_sub(x, uint128_mul64x64(z0, z0)).z1, 0, 0 };
+  Flag negative = sub192(r, (const Uint64[3]){twice.z0, twice.z1, 0});
+  negative |= sub192(r, (const Uint64[3]){0, square.z0, square.z1});
+  if (negative) {
+    do {
+      z1--;
+    } while (!add192(r, (const Uint64[3]){0, (z0 << 1) | (z1 >> 63), (z1 << 1) | 1}));
+  }
+  Uint128 sig = {z0, z1};
+  sig.z1 |= (r[0] | r[1] | r[2]) != 0;
+  return float128_round_and_pack(ctx, 0, exp, sig);
+}
+
+Float128 float32_to_float128(Context *ctx, Float32 a) {
+  Uint32 a_sig = float32_fract(a);
+  Sint32 a_exp = float32_exp(a);
+  Flag a_sign = float32_sign(a);
+  if (a_exp == 0xff) {
+    return a_sig
+      ? canonical_nan_to_float128(float32_to_canonical_nan(ctx, a))
+      : float128_pack(a_sign, 0x7fff, (Uint128){0, 0});
+  }
+  if (a_exp == 0) {
+    if (a_sig == 0) {
+      return float128_pack(a_sign, 0, (Uint128){0, 0});
+    }
+    Normal32 normal = float32_normalize_subnormal(a_sig);
+    a_exp = normal.exp;
+    a_sig = normal.sig;
+    a_exp--;
+  }
+  return float128_pack(a_sign, a_exp + 0x3f80, uint128_shl((Uint128){0, a_sig}, 89));
+}
+
+Float128 float64_to_float128(Context *ctx, Float64 a) {
+  Uint64 a_sig = float64_fract(a);
+  Sint32 a_exp = float64_exp(a);
+  Flag a_sign = float64_sign(a);
+  if (a_exp == 0x7ff) {
+    return a_sig
+      ? canonical_nan_to_float128(float64_to_canonical_nan(ctx, a))
+      : float128_pack(a_sign, 0x7fff, (Uint128){0, 0});
+  }
+  if (a_exp == 0) {
+    if (a_sig == 0) {
+      return float128_pack(a_sign, 0, (Uint128){0, 0});
+    }
+    Normal64 normal = float64_normalize_subnormal(a_sig);
+    a_exp = normal.exp;
+    a_sig = normal.sig;
+    a_exp--;
+  }
+  return float128_pack(a_sign, a_exp + 0x3c00, uint128_shl((Uint128){0, a_sig}, 60));
+}
+
+Float32 float128_to_float32(Context *ctx, Float128 a) {
+  Uint128 a_sig = float128_fract(a);
+  Sint32 a_exp = float128_exp(a);
+  Flag a_sign = float128_sign(a);
+  if (a_exp == 0x7fff) {
+    return !is_zero(a_sig)
+      ? canonical_nan_to_float32(float128_to_canonical_nan(ctx, a))
+      : float32_pack(a_sign, 0xff, 0);
+  }
+  Uint32 sig = uint128_rshr(a_sig, 82).z1;
+  if (a_exp || sig) {
+    sig |= LIT32(0x40000000);
+    a_exp -= 0x3f81;
+  }
+  return float32_round_and_pack(ctx, a_sign, a_exp, sig);
+}
+
+Float64 float128_to_float64(Context *ctx, Float128 a) {
+  Uint128 a_sig = float128_fract(a);
+  Sint32 a_exp = float128_exp(a);
+  Flag a_sign = float128_sign(a);
+  if (a_exp == 0x7fff) {
+    return !is_zero(a_sig)
+      ? canonical_nan_to_float64(float128_to_canonical_nan(ctx, a))
+      : float64_pack(a_sign, 0x7ff, 0);
+  }
+  Uint64 sig = uint128_rshr(a_sig, 50).z1;
+  if (a_exp || sig) {
+    sig |= LIT64(0x4000000000000000);
+    a_exp -= 0x3c01;
+  }
+  return float64_round_and_pack(ctx, a_sign, a_exp, sig);
+}
@@ -0,0 +1,76 @@
+#ifndef SOFT128_H
+#define SOFT128_H
+#include "soft.h"
+#include "uint128.h"
+
+typedef struct Float128 Float128;
+typedef struct Normal128 Normal128;
+
+// Quadruple-precision float, z0 holds the sign, exponent and the high 48 bits
+// of the significant.
+struct Float128 {
+  Uint128 bits;
+};
+
+struct Normal128 {
+  Uint128 sig;
+  Sint32 exp;
+};
+
+static inline Uint128 float128_fract(Float128 a) {
+  return (Uint128){a.bits.z0 & LIT64(0x0000FFFFFFFFFFFF), a.bits.z1};
+}
+
+static inline Sint32 float128_exp(Float128 a) {
+  return (a.bits.z0 >> 48) & 0x7fff;
+}
+
+static inline Flag float128_sign(Float128 a) {
+  return a.bits.z0 >> 63;
+}
+
+static inline Flag float128_is_nan(Float128 a) {
+  return LIT64(0xFFFE000000000000) <= (Uint64)(a.bits.z0 << 1)
+    && (a.bits.z1 || (a.bits.z0 & LIT64(0x0000FFFFFFFFFFFF)));
+}
+
+static inline Flag float128_is_snan(Float128 a) {
+  return ((a.bits.z0 >> 47) & 0xffff) == 0xfffe
+    && (a.bits.z1 || (a.bits.z0 & LIT64(0x00007FFFFFFFFFFF)));
+}
+
+// Pack sign, exponent, and significant into quadruple-precision float.
+static inline Float128 float128_pack(Flag sign, Sint32 exp, Uint128 sig) {
+  return (Float128){{(((Uint64)sign) << 63) + (((Uint64)exp) << 48) + sig.z0, sig.z1}};
+}
+
+// Common constants.
+static const Float128 FLOAT128_NAN = {{LIT64(0xffffffffffffffff), LIT64(0xffffffffffffffff)}};
+static const Float128 FLOAT128_ZERO = {{0, 0}}; // 0x0p+0
+
+// Conversion of float128 NaN to CanonicalNaN format.
+CanonicalNaN float128_to_canonical_nan(Context*, Float128);
+
+// Normalize subnormal.
+Normal128 float128_normalize_subnormal(Uint128 sig);
+
+// Build a float128 from sign, exponent, and significant with correct rounding.
+// The significant has its leading bit at bit 126 like [float64_round_and_pack]
+// has it at bit 62, the low 14 bits are rounded off. Unlike float32 and float64
+// the rounding and tininess modes are read from the context on every call.
+Float128 float128_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint128 sig);
+
+// Arithmetic functions.
+Float128 float128_add(Context*, Float128, Float128); // a + b
+Float128 float128_sub(Context*, Float128, Float128); // a - b
+Float128 float128_mul(Context*, Float128, Float128); // a * b
+Float128 float128_div(Context*, Float128, Float128); // a / b
+Float128 float128_sqrt(Context*, Float128); // sqrt(a)
+
+// Conversions, widening is always exact.
+Float128 float32_to_float128(Context*, Float32);
+Float128 float64_to_float128(Context*, Float64);
+Float32 float128_to_float32(Context*, Float128);
+Float64 float128_to_float64(Context*, Float128);
+
+#endif // FLOAT128_H
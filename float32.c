@@ -5,10 +5,15 @@ static inline Sint8 count_leading_zeros_u32(Uint32 a) {
   return a == 0 ? 32 : __builtin_clz(a);
 }
 
+static inline Sint8 count_leading_zeros_u64(Uint64 a) {
+  return a == 0 ? 64 : __builtin_clzll(a);
+}
+
 // Take two single-precision float values, one which must be NaN, and produce
 // the correct NaN result, taking care to raise an invalid exception when either
 // is a signaling NaN.
 static Float32 float32_propagate_nan(Context *ctx, Float32 a, Float32 b) {
+  STATS(ctx, nans, 1);
   const Flag a_is_nan = float32_is_nan(a);
   const Flag a_is_snan = float32_is_snan(a);
   const Flag b_is_nan = float32_is_nan(b);
@@ -24,6 +29,22 @@ static Float32 float32_propagate_nan(Context *ctx, Float32 a, Float32 b) {
   return b;
 }
 
+// The same for three values, at least one of which must be NaN, where the first
+// NaN of [a], [b] and [c] is the result.
+static Float32 float32_propagate_nan3(Context *ctx, Float32 a, Float32 b, Float32 c) {
+  STATS(ctx, nans, 1);
+  if (float32_is_snan(a) | float32_is_snan(b) | float32_is_snan(c)) {
+    context_raise(ctx, EXCEPTION_INVALID);
+  }
+  if (float32_is_any_nan(a)) {
+    return (Float32){a.bits | LIT32(0x00400000)};
+  }
+  if (float32_is_any_nan(b)) {
+    return (Float32){b.bits | LIT32(0x00400000)};
+  }
+  return (Float32){c.bits | LIT32(0x00400000)};
+}
+
 CanonicalNaN float32_to_canonical_nan(Context* ctx, Float32 a) {
   if (float32_is_snan(a)) {
     context_raise(ctx, EXCEPTION_INVALID);
@@ -35,8 +56,11 @@ CanonicalNaN float32_to_canonical_nan(Context* ctx, Float32 a) {
   return nan;
 }
 
-Float32 float32_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint32 sig) {
-  const Round rounding_mode = ctx->round;
+// Everything from here to the specializations below is inlined into them with
+// constant rounding and tininess modes, which folds away every branch on them.
+#define INLINE static inline __attribute__((always_inline))
+
+INLINE Float32 round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint32 sig, const Round rounding_mode, const Tininess tininess) {
   const Flag round_nearest_even = rounding_mode == ROUND_NEAREST_EVEN;
   Sint8 round_increment = 0x40;
   if (!round_nearest_even) {
@@ -65,11 +89,12 @@ Float32 float32_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint32 sig)
   if (0xfd <= (Uint16)exp) {
     if ((0xfd < exp) || ((exp == 0xfd) && ((Sint32)(sig + round_increment) < 0))) {
       context_raise(ctx, EXCEPTION_OVERFLOW | EXCEPTION_INEXACT);
+      STATS(ctx, rounded[(round_increment != 0) ^ sign], 1);
       const Float32 pack = float32_pack(sign, 0xff, 0);
-      return (Float32){pack.bits - (round_increment == 0 ? 0 : 1)};
+      return (Float32){pack.bits - (round_increment == 0 ? 1 : 0)};
     }
     if (exp < 0) {
-      const Flag is_tiny = (ctx->tininess == TININESS_BEFORE_ROUNDING)
+      const Flag is_tiny = (tininess == TININESS_BEFORE_ROUNDING)
         || (exp < -1)
         || (sig + round_increment < LIT32(0x80000000));
       sig = rshr32(sig, -exp);
@@ -83,14 +108,16 @@ Float32 float32_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint32 sig)
   if (round_bits) {
     context_raise(ctx, EXCEPTION_INEXACT);
   }
+  const Uint32 truncated = sig >> 7;
   sig = (sig + round_increment) >> 7;
   sig &= ~(((round_bits ^ 0x40) == 0) & round_nearest_even);
+  STATS(ctx, rounded[(sig != truncated) ^ sign], round_bits != 0);
   return float32_pack(sign, sig == 0 ? 0 : exp, sig);
 }
 
-static inline Float32 float32_normalize_round_and_pack(Context *ctx, Flag sign, Sint16 exp, Uint32 sig) {
+INLINE Float32 normalize_round_and_pack(Context *ctx, Flag sign, Sint16 exp, Uint32 sig, const Round round, const Tininess tininess) {
   const Sint8 shift = count_leading_zeros_u32(sig) - 1;
-  return float32_round_and_pack(ctx, sign, exp - shift, sig << shift);
+  return round_and_pack(ctx, sign, exp - shift, sig << shift, round, tininess);
 }
 
 Normal32 float32_normalize_subnormal(Uint32 sig) {
@@ -98,7 +125,7 @@ Normal32 float32_normalize_subnormal(Uint32 sig) {
   return (Normal32){sig << shift, 1 - shift};
 }
 
-static Float32 float32_add_sig(Context *ctx, Float32 a, Float32 b, Flag sign) {
+INLINE Float32 add_sig(Context *ctx, Float32 a, Float32 b, Flag sign, const Round round, const Tininess tininess) {
   Sint16 a_exp = float32_exp(a);
   Sint16 b_exp = float32_exp(b);
   Uint32 a_sig = float32_fract(a) << 6;
@@ -151,10 +178,10 @@ static Float32 float32_add_sig(Context *ctx, Float32 a, Float32 b, Flag sign) {
     exp++;
   }
 round_and_pack:
-  return float32_round_and_pack(ctx, sign, exp, sig);
+  return round_and_pack(ctx, sign, exp, sig, round, tininess);
 }
 
-static Float32 float32_sub_sig(Context *ctx, Float32 a, Float32 b, Flag sign) {
+INLINE Float32 sub_sig(Context *ctx, Float32 a, Float32 b, Flag sign, const Round round, const Tininess tininess) {
   Sint16 a_exp = float32_exp(a);
   Sint16 b_exp = float32_exp(b);
   Uint32 a_sig = float32_fract(a) << 7;
@@ -187,7 +214,7 @@ static Float32 float32_sub_sig(Context *ctx, Float32 a, Float32 b, Flag sign) {
   if (a_sig < b_sig) {
     goto b_bigger;
   }
-  return float32_pack(ctx->round == ROUND_DOWN, 0, 0);
+  return float32_pack(round == ROUND_DOWN, 0, 0);
 b_exp_bigger:
   if (b_exp == 0xff) {
     return b_sig
@@ -222,29 +249,26 @@ a_bigger:
   exp = a_exp;
 normalize_round_and_pack:
   exp--;
-  return float32_normalize_round_and_pack(ctx, sign, exp, sig);
+  return normalize_round_and_pack(ctx, sign, exp, sig, round, tininess);
 }
 
-Float32 float32_add(Context *ctx, Float32 a, Float32 b) {
-  array_push(ctx->operations, OPERATION_ADD);
+INLINE Float32 add(Context *ctx, Float32 a, Float32 b, const Round round, const Tininess tininess) {
   const Flag a_sign = float32_sign(a);
   const Flag b_sign = float32_sign(b);
   return a_sign == b_sign
-    ? float32_add_sig(ctx, a, b, a_sign)
-    : float32_sub_sig(ctx, a, b, a_sign);
+    ? add_sig(ctx, a, b, a_sign, round, tininess)
+    : sub_sig(ctx, a, b, a_sign, round, tininess);
 }
 
-Float32 float32_sub(Context *ctx, Float32 a, Float32 b) {
-  array_push(ctx->operations, OPERATION_SUB);
+INLINE Float32 sub(Context *ctx, Float32 a, Float32 b, const Round round, const Tininess tininess) {
   const Flag a_sign = float32_sign(a);
   const Flag b_sign = float32_sign(b);
   return a_sign == b_sign
-    ? float32_sub_sig(ctx, a, b, a_sign)
-    : float32_add_sig(ctx, a, b, a_sign);
+    ? sub_sig(ctx, a, b, a_sign, round, tininess)
+    : add_sig(ctx, a, b, a_sign, round, tininess);
 }
 
-Float32 float32_mul(Context *ctx, Float32 a, Float32 b) {
-  array_push(ctx->operations, OPERATION_MUL);
+INLINE Float32 mul(Context *ctx, Float32 a, Float32 b, const Round round, const Tininess tininess) {
   Sint16 a_exp = float32_exp(a);
   Sint16 b_exp = float32_exp(b);
   Uint32 a_sig = float32_fract(a);
@@ -285,7 +309,7 @@ Float32 float32_mul(Context *ctx, Float32 a, Float32 b) {
     exp--;
     sig <<= 1;
   }
-  return float32_round_and_pack(ctx, sign, exp, sig);
+  return round_and_pack(ctx, sign, exp, sig, round, tininess);
 propagate_nan:
   return float32_propagate_nan(ctx, a, b);
 infinity:
@@ -299,8 +323,7 @@ zero:
   return float32_pack(sign, 0, 0);
 }
 
-Float32 float32_div(Context *ctx, Float32 a, Float32 b) {
-  array_push(ctx->operations, OPERATION_DIV);
+INLINE Float32 div(Context *ctx, Float32 a, Float32 b, const Round round, const Tininess tininess) {
   Sint16 a_exp = float32_exp(a);
   Sint16 b_exp = float32_exp(b);
   Uint32 a_sig = float32_fract(a);
@@ -351,7 +374,7 @@ Float32 float32_div(Context *ctx, Float32 a, Float32 b) {
   if (!(sig & 0x3f)) {
     sig |= ((Uint64)b_sig * sig != a_sig_64);
   }
-  return float32_round_and_pack(ctx, sign, exp, sig);
+  return round_and_pack(ctx, sign, exp, sig, round, tininess);
 propagate_nan:
   return float32_propagate_nan(ctx, a, b);
 invalid:
@@ -363,8 +386,210 @@ zero:
   return float32_pack(sign, 0, 0);
 }
 
+// The product is exact in 64 bits, the addend is aligned to it and only the
+// sum is rounded.
+INLINE Float32 mul_add(Context *ctx, Float32 a, Float32 b, Float32 c, const Round round, const Tininess tininess) {
+  Sint32 a_exp = float32_exp(a);
+  Sint32 b_exp = float32_exp(b);
+  Sint32 c_exp = float32_exp(c);
+  Uint32 a_sig = float32_fract(a);
+  Uint32 b_sig = float32_fract(b);
+  Uint32 c_sig = float32_fract(c);
+  const Flag c_sign = float32_sign(c);
+  const Flag sign = float32_sign(a) ^ float32_sign(b);
+  const Flag a_zero = (a_exp | a_sig) == 0;
+  const Flag b_zero = (b_exp | b_sig) == 0;
+  const Flag c_zero = (c_exp | c_sig) == 0;
+  if (float32_is_any_nan(a) || float32_is_any_nan(b) || float32_is_any_nan(c)) {
+    return float32_propagate_nan3(ctx, a, b, c);
+  }
+  if (a_exp == 0xff || b_exp == 0xff) {
+    // Infinity times zero, or an infinite product and addend of opposite sign.
+    if (a_zero || b_zero || (c_exp == 0xff && c_sign != sign)) {
+      context_raise(ctx, EXCEPTION_INVALID);
+      return FLOAT32_NAN;
+    }
+    return float32_pack(sign, 0xff, 0);
+  }
+  if (c_exp == 0xff) {
+    return c;
+  }
+  if (a_zero || b_zero) {
+    // Zeros of opposite sign sum to zero with the sign of the rounding mode.
+    if (c_zero && c_sign != sign) {
+      return float32_pack(round == ROUND_DOWN, 0, 0);
+    }
+    return c;
+  }
+
+  if (a_exp == 0) {
+    const Normal32 n = float32_normalize_subnormal(a_sig);
+    a_exp = n.exp;
+    a_sig = n.sig;
+  }
+  if (b_exp == 0) {
+    const Normal32 n = float32_normalize_subnormal(b_sig);
+    b_exp = n.exp;
+    b_sig = n.sig;
+  }
+
+  // The product has 48 bits, placed below bit 62 so the sum cannot carry out.
+  Uint64 sig = ((Uint64)(a_sig | LIT32(0x00800000)) * (b_sig | LIT32(0x00800000))) << 14;
+  Sint32 exp = a_exp + b_exp - 0x13a;
+  Flag r_sign = sign;
+
+  if (!c_zero) {
+    if (c_exp == 0) {
+      const Normal32 n = float32_normalize_subnormal(c_sig);
+      c_exp = n.exp;
+      c_sig = n.sig;
+    }
+    Uint64 addend = (Uint64)(c_sig | LIT32(0x00800000)) << 38;
+    Sint32 addend_exp = c_exp - 0xbc;
+    // Only the operand with the smaller exponent loses bits to the alignment,
+    // and only when it is too small for the sum to need them.
+    if (exp < addend_exp) {
+      sig = rshr64(sig, addend_exp - exp < 64 ? addend_exp - exp : 64);
+      exp = addend_exp;
+    } else {
+      addend = rshr64(addend, exp - addend_exp < 64 ? exp - addend_exp : 64);
+    }
+    if (sign == c_sign) {
+      sig += addend;
+    } else if (sig >= addend) {
+      sig -= addend;
+    } else {
+      sig = addend - sig;
+      r_sign = c_sign;
+    }
+    if (sig == 0) {
+      return float32_pack(round == ROUND_DOWN, 0, 0);
+    }
+  }
+
+  const Sint8 shift = count_leading_zeros_u64(sig) - 1;
+  sig <<= shift;
+  exp -= shift;
+  return round_and_pack(ctx, r_sign, exp + 0xbc, rshr64(sig, 32), round, tininess);
+}
+
+#define SPECIALIZE(suffix, round, tininess) \
+  static Float32 round_and_pack_##suffix(Context *ctx, Flag sign, Sint32 exp, Uint32 sig) { \
+    return round_and_pack(ctx, sign, exp, sig, round, tininess); \
+  } \
+  static Float32 add_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return add(ctx, a, b, round, tininess); \
+  } \
+  static Float32 sub_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return sub(ctx, a, b, round, tininess); \
+  } \
+  static Float32 mul_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return mul(ctx, a, b, round, tininess); \
+  } \
+  static Float32 div_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return div(ctx, a, b, round, tininess); \
+  } \
+  static Float32 fma_##suffix(Context *ctx, Float32 a, Float32 b, Float32 c) { \
+    return mul_add(ctx, a, b, c, round, tininess); \
+  } \
+  static const Float32Ops OPS_##suffix = { \
+    round_and_pack_##suffix, \
+    add_##suffix, \
+    sub_##suffix, \
+    mul_##suffix, \
+    div_##suffix, \
+    fma_##suffix \
+  };
+
+SPECIALIZE(nearest_even_after, ROUND_NEAREST_EVEN, TININESS_AFTER_ROUNDING)
+SPECIALIZE(nearest_even_before, ROUND_NEAREST_EVEN, TININESS_BEFORE_ROUNDING)
+SPECIALIZE(to_zero_after, ROUND_TO_ZERO, TININESS_AFTER_ROUNDING)
+SPECIALIZE(to_zero_before, ROUND_TO_ZERO, TININESS_BEFORE_ROUNDING)
+SPECIALIZE(down_after, ROUND_DOWN, TININESS_AFTER_ROUNDING)
+SPECIALIZE(down_before, ROUND_DOWN, TININESS_BEFORE_ROUNDING)
+SPECIALIZE(up_after, ROUND_UP, TININESS_AFTER_ROUNDING)
+SPECIALIZE(up_before, ROUND_UP, TININESS_BEFORE_ROUNDING)
+
+// Indexed by Round then Tininess.
+static const Float32Ops *const OPS[4][2] = {
+  { &OPS_nearest_even_after, &OPS_nearest_even_before },
+  { &OPS_to_zero_after,      &OPS_to_zero_before      },
+  { &OPS_down_after,         &OPS_down_before         },
+  { &OPS_up_after,           &OPS_up_before           }
+};
+
+const Float32Ops *float32_ops(Round round, Tininess tininess) {
+  return OPS[round][tininess];
+}
+
+Float32 float32_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint32 sig) {
+  return ctx->float32->round_and_pack(ctx, sign, exp, sig);
+}
+
+// Counts an operation with operands [a] and [b] and result [r] in the stats of
+// the context.
+static inline Float32 counted(Context *ctx, Size operation, Float32 a, Float32 b, Float32 r) {
+  STATS(ctx, operations[operation], 1);
+  STATS(ctx, subnormal_inputs, float32_is_subnormal(a) + float32_is_subnormal(b));
+  STATS(ctx, subnormal_outputs, float32_is_subnormal(r));
+  return r;
+}
+
+Float32 float32_add_untrapped(Context *ctx, Float32 a, Float32 b) {
+  context_operation(ctx, OPERATION_ADD);
+  return counted(ctx, STATS_ADD, a, b, ctx->float32->add(ctx, a, b));
+}
+
+Float32 float32_add(Context *ctx, Float32 a, Float32 b) {
+  ctx->trapped = 0;
+  const Float32 r = float32_add_untrapped(ctx, a, b);
+  return ctx->trapped ? context_trap(ctx, OPERATION_ADD, a, b, FLOAT32_ZERO, r) : r;
+}
+
+Float32 float32_sub_untrapped(Context *ctx, Float32 a, Float32 b) {
+  context_operation(ctx, OPERATION_SUB);
+  return counted(ctx, STATS_SUB, a, b, ctx->float32->sub(ctx, a, b));
+}
+
+Float32 float32_sub(Context *ctx, Float32 a, Float32 b) {
+  ctx->trapped = 0;
+  const Float32 r = float32_sub_untrapped(ctx, a, b);
+  return ctx->trapped ? context_trap(ctx, OPERATION_SUB, a, b, FLOAT32_ZERO, r) : r;
+}
+
+Float32 float32_mul_untrapped(Context *ctx, Float32 a, Float32 b) {
+  context_operation(ctx, OPERATION_MUL);
+  return counted(ctx, STATS_MUL, a, b, ctx->float32->mul(ctx, a, b));
+}
+
+Float32 float32_mul(Context *ctx, Float32 a, Float32 b) {
+  ctx->trapped = 0;
+  const Float32 r = float32_mul_untrapped(ctx, a, b);
+  return ctx->trapped ? context_trap(ctx, OPERATION_MUL, a, b, FLOAT32_ZERO, r) : r;
+}
+
+Float32 float32_div_untrapped(Context *ctx, Float32 a, Float32 b) {
+  context_operation(ctx, OPERATION_DIV);
+  return counted(ctx, STATS_DIV, a, b, ctx->float32->div(ctx, a, b));
+}
+
+Float32 float32_div(Context *ctx, Float32 a, Float32 b) {
+  ctx->trapped = 0;
+  const Float32 r = float32_div_untrapped(ctx, a, b);
+  return ctx->trapped ? context_trap(ctx, OPERATION_DIV, a, b, FLOAT32_ZERO, r) : r;
+}
+
+Float32 float32_fma(Context *ctx, Float32 a, Float32 b, Float32 c) {
+  ctx->trapped = 0;
+  context_operation(ctx, OPERATION_FMA);
+  STATS(ctx, subnormal_inputs, float32_is_subnormal(c));
+  const Float32 r = counted(ctx, STATS_FMA, a, b, ctx->float32->fma(ctx, a, b, c));
+  return ctx->trapped ? context_trap(ctx, OPERATION_FMA, a, b, c, r) : r;
+}
+
 // a == b
 Flag float32_eq(Context *ctx, Float32 a, Float32 b) {
+  STATS(ctx, operations[STATS_COMPARE], 1);
   if ((float32_exp(a) == 0xff && float32_fract(a)) ||
       (float32_exp(b) == 0xff && float32_fract(b)))
   {
@@ -378,6 +603,7 @@ Flag float32_eq(Context *ctx, Float32 a, Float32 b) {
 
 // a <= b
 Flag float32_lte(Context *ctx, Float32 a, Float32 b) {
+  STATS(ctx, operations[STATS_COMPARE], 1);
   if ((float32_exp(a) == 0xff && float32_fract(a)) ||
       (float32_exp(b) == 0xff && float32_fract(b)))
   {
@@ -397,6 +623,7 @@ Flag float32_lte(Context *ctx, Float32 a, Float32 b) {
 
 // a < b
 Flag float32_lt(Context *ctx, Float32 a, Float32 b) {
+  STATS(ctx, operations[STATS_COMPARE], 1);
   if ((float32_exp(a) == 0xff && float32_fract(a)) ||
       (float32_exp(b) == 0xff && float32_fract(b)))
   {
@@ -431,13 +658,55 @@ Flag float32_gt(Context *ctx, Float32 a, Float32 b) {
   return !float32_lte(ctx, a, b);
 }
 
-Float32 float32_from_sint32(Context *ctx, Sint32 a) {
+// Every integer conversion goes through the magnitude as a 64-bit integer.
+static Float32 from_integer(Context *ctx, Flag sign, Uint64 a) {
+  STATS(ctx, operations[STATS_CONVERT], 1);
   if (a == 0) {
     return (Float32){0};
   }
-  if (a == (Sint32)0x80000000) {
-    return float32_pack(1, 0x9e, 0);
-  }
-  const Flag sign = a < 0;
-  return float32_normalize_round_and_pack(ctx, sign, 0x9c, sign ? -a : a);
+  const Sint8 shift = count_leading_zeros_u64(a);
+  return float32_round_and_pack(ctx, sign, 0xbd - shift, rshr64(a << shift, 33));
+}
+
+Float32 float32_from_sint32(Context *ctx, Sint32 a) {
+  return from_integer(ctx, a < 0, a < 0 ? -(Uint64)a : (Uint64)a);
+}
+
+Float32 float32_from_uint32(Context *ctx, Uint32 a) {
+  return from_integer(ctx, 0, a);
+}
+
+Float32 float32_from_sint64(Context *ctx, Sint64 a) {
+  return from_integer(ctx, a < 0, a < 0 ? -(Uint64)a : (Uint64)a);
+}
+
+Float32 float32_from_uint64(Context *ctx, Uint64 a) {
+  return from_integer(ctx, 0, a);
+}
+
+static Uint64 to_integer(Context *ctx, Float32 a, Uint64 max_positive, Uint64 max_negative, Uint64 invalid) {
+  STATS(ctx, operations[STATS_CONVERT], 1);
+  Uint8 raised;
+  const Uint64 r = float32_to_integer(a, ctx->config.round, max_positive, max_negative, invalid, &raised);
+  if (raised) {
+    ctx->roundings += raised == EXCEPTION_INEXACT;
+    context_raise(ctx, raised);
+  }
+  return r;
+}
+
+Sint32 float32_to_sint32(Context *ctx, Float32 a) {
+  return (Uint32)to_integer(ctx, a, LIT64(0x7fffffff), LIT64(0x80000000), LIT64(0x80000000));
+}
+
+Uint32 float32_to_uint32(Context *ctx, Float32 a) {
+  return to_integer(ctx, a, LIT64(0xffffffff), 0, LIT64(0xffffffff));
+}
+
+Sint64 float32_to_sint64(Context *ctx, Float32 a) {
+  return to_integer(ctx, a, LIT64(0x7fffffffffffffff), LIT64(0x8000000000000000), LIT64(0x8000000000000000));
+}
+
+Uint64 float32_to_uint64(Context *ctx, Float32 a) {
+  return to_integer(ctx, a, LIT64(0xffffffffffffffff), 0, LIT64(0xffffffffffffffff));
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ static inline Flag float32_sign(Float32 a) {
 }
 
 static inline Flag float32_is_nan(Float32 a) {
-  return LIT32(0xFF000000) << (Uint32)(a.bits << 1);
+  return LIT32(0xFF000000) < (Uint32)(a.bits << 1);
 }
 
 static inline Flag float32_is_snan(Float32 a) {
@@ -26,6 +26,10 @@ static inline Flag float32_is_any_nan(Float32 a) {
   return (a.bits & LIT32(0x7fffffff)) > LIT32(0x7f800000);
 }
 
+static inline Flag float32_is_subnormal(Float32 a) {
+  return float32_exp(a) == 0 && float32_fract(a) != 0;
+}
+
 // Pack sign, exponent, and significant into single-precision float.
 static inline Float32 float32_pack(Flag sign, Sint16 exp, Uint32 sig) {
   return (Float32){(((Uint32)sign) << 31) + (((Uint32)exp) << 23) + sig};
@@ -42,6 +46,11 @@ static inline Float32 float32_pack(Flag sign, Sint16 exp, Uint32 sig) {
 // Conversion of float32 NaN to CanonicalNaN format.
 CanonicalNaN float32_to_canonical_nan(Context*, Float32);
 
+// Conversion of CanonicalNaN format to float32 NaN.
+static inline Float32 canonical_nan_to_float32(CanonicalNaN nan) {
+  return (Float32){(((Uint32)nan.sign) << 31) | LIT32(0x7FC00000) | (nan.hi >> 41)};
+}
+
 // Normalize a subnormal.
 Normal32 float32_normalize_subnormal(Uint32 sig);
 
@@ -53,6 +62,14 @@ Float32 float32_add(Context*, Float32, Float32); // a + b
 Float32 float32_sub(Context*, Float32, Float32); // a - b
 Float32 float32_mul(Context*, Float32, Float32); // a * b
 Float32 float32_div(Context*, Float32, Float32); // a / b
+Float32 float32_fma(Context*, Float32, Float32, Float32); // a * b + c, rounded once
+
+// The same without the trap, for kernels made of them that trap once as a
+// whole. What they raise accumulates in the trapped flags of the context.
+Float32 float32_add_untrapped(Context*, Float32, Float32);
+Float32 float32_sub_untrapped(Context*, Float32, Float32);
+Float32 float32_mul_untrapped(Context*, Float32, Float32);
+Float32 float32_div_untrapped(Context*, Float32, Float32);
 
 // Relational functions.
 Flag float32_eq(Context*, Float32, Float32); // a == b
@@ -62,10 +79,32 @@ Flag float32_ne(Context*, Float32, Float32); // a != b
 Flag float32_gte(Context*, Float32, Float32); // a >= b
 Flag float32_gt(Context*, Float32, Float32); // a > b
 
-// Conversion functions.
+// Conversion functions. Conversions to integers round in the rounding mode of
+// the context, NaNs and values out of range raise invalid and give the integer
+// indefinite: the most negative value for signed and all ones for unsigned.
 Float32 float32_from_sint32(Context *ctx, Sint32 x);
+Float32 float32_from_uint32(Context *ctx, Uint32 x);
+Float32 float32_from_sint64(Context *ctx, Sint64 x);
+Float32 float32_from_uint64(Context *ctx, Uint64 x);
+Sint32 float32_to_sint32(Context*, Float32);
+Uint32 float32_to_uint32(Context*, Float32);
+Sint64 float32_to_sint64(Context*, Float32);
+Uint64 float32_to_uint64(Context*, Float32);
+
+// The conversions to integers without a context, see integer_round_and_pack.
+static inline Uint64 float32_to_integer(Float32 a, Round round, Uint64 max_positive, Uint64 max_negative, Uint64 invalid, Uint8 *raised) {
+  const Sint16 a_exp = float32_exp(a);
+  const Uint64 a_sig = a_exp ? float32_fract(a) | LIT32(0x00800000) : float32_fract(a);
+  const Sint32 count = 0x96 - (a_exp ? a_exp : 1);
+  if (a_exp == 0xff || count < -40) {
+    return integer_round_and_pack(round, 0, 0, -1, max_positive, max_negative, invalid, raised);
+  }
+  return count < 0
+    ? integer_round_and_pack(round, float32_sign(a), a_sig << -count, 0, max_positive, max_negative, invalid, raised)
+    : integer_round_and_pack(round, float32_sign(a), a_sig, count, max_positive, max_negative, invalid, raised);
+}
 
-// Needed temporarily for printing.
+// Host view of a float32, used where a linear sweep steps in host arithmetic.
 static inline float float32_cast(Float32 x) {
   union { Float32 s; float h; } u = {x};
   return u.h;
@@ -10,6 +10,7 @@ static inline Sint8 count_leading_zeros_u64(Uint64 a) {
 // the correct NaN result, taking care to raise an invalid exception when either
 // is a signaling NaN.
 static Float64 float64_propagate_nan(Context *ctx, Float64 a, Float64 b) {
+  STATS(ctx, nans, 1);
   const Flag a_is_nan = float64_is_nan(a);
   const Flag a_is_snan = float64_is_snan(a);
   const Flag b_is_nan = float64_is_nan(b);
@@ -25,6 +26,22 @@ static Float64 float64_propagate_nan(Context *ctx, Float64 a, Float64 b) {
   return b;
 }
 
+// The same for three values, at least one of which must be NaN, where the first
+// NaN of [a], [b] and [c] is the result.
+static Float64 float64_propagate_nan3(Context *ctx, Float64 a, Float64 b, Float64 c) {
+  STATS(ctx, nans, 1);
+  if (float64_is_snan(a) | float64_is_snan(b) | float64_is_snan(c)) {
+    context_raise(ctx, EXCEPTION_INVALID);
+  }
+  if (float64_is_any_nan(a)) {
+    return (Float64){a.bits | LIT64(0x0008000000000000)};
+  }
+  if (float64_is_any_nan(b)) {
+    return (Float64){b.bits | LIT64(0x0008000000000000)};
+  }
+  return (Float64){c.bits | LIT64(0x0008000000000000)};
+}
+
 CanonicalNaN float64_to_canonical_nan(Context* ctx, Float64 a) {
   if (float64_is_snan(a)) {
     context_raise(ctx, EXCEPTION_INVALID);
@@ -36,8 +53,11 @@ CanonicalNaN float64_to_canonical_nan(Context* ctx, Float64 a) {
   return nan;
 }
 
-Float64 float64_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint64 sig) {
-  const Round rounding_mode = ctx->round;
+// Everything from here to the specializations below is inlined into them with
+// constant rounding and tininess modes, which folds away every branch on them.
+#define INLINE static inline __attribute__((always_inline))
+
+INLINE Float64 round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint64 sig, const Round rounding_mode, const Tininess tininess) {
   const Flag round_nearest_even = rounding_mode == ROUND_NEAREST_EVEN;
   Sint16 round_increment = 0x200;
   if (!round_nearest_even) {
@@ -66,11 +86,12 @@ Float64 float64_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint64 sig)
   if (0x7fd <= (Uint16)exp) {
     if ((0x7fd < exp) || ((exp == 0x7fd) && ((Sint64)(sig + round_increment) < 0))) {
       context_raise(ctx, EXCEPTION_OVERFLOW | EXCEPTION_INEXACT);
+      STATS(ctx, rounded[(round_increment != 0) ^ sign], 1);
       const Float64 pack = float64_pack(sign, 0x7ff, 0);
-      return (Float64){pack.bits - (round_increment == 0 ? 0 : 1)};
+      return (Float64){pack.bits - (round_increment == 0 ? 1 : 0)};
     }
     if (exp < 0) {
-      const Flag is_tiny = (ctx->tininess == TININESS_BEFORE_ROUNDING)
+      const Flag is_tiny = (tininess == TININESS_BEFORE_ROUNDING)
         || (exp < -1)
         || (sig + round_increment < LIT64(0x8000000000000000));
       sig = rshr64(sig, -exp);
@@ -84,14 +105,16 @@ Float64 float64_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint64 sig)
   if (round_bits) {
     context_raise(ctx, EXCEPTION_INEXACT);
   }
+  const Uint64 truncated = sig >> 10;
   sig = (sig + round_increment) >> 10;
   sig &= ~(((round_bits ^ 0x200) == 0) & round_nearest_even);
+  STATS(ctx, rounded[(sig != truncated) ^ sign], round_bits != 0);
   return float64_pack(sign, sig == 0 ? 0 : exp, sig);
 }
 
-static inline Float64 float64_normalize_round_and_pack(Context *ctx, Flag sign, Sint16 exp, Uint64 sig) {
+INLINE Float64 normalize_round_and_pack(Context *ctx, Flag sign, Sint16 exp, Uint64 sig, const Round round, const Tininess tininess) {
   const Sint8 shift = count_leading_zeros_u64(sig) - 1;
-  return float64_round_and_pack(ctx, sign, exp - shift, sig << shift);
+  return round_and_pack(ctx, sign, exp - shift, sig << shift, round, tininess);
 }
 
 Normal64 float64_normalize_subnormal(Uint64 sig) {
@@ -99,7 +122,7 @@ Normal64 float64_normalize_subnormal(Uint64 sig) {
   return (Normal64){sig << shift, 1 - shift};
 }
 
-static Float64 float64_add_sig(Context *ctx, Float64 a, Float64 b, Flag sign) {
+INLINE Float64 add_sig(Context *ctx, Float64 a, Float64 b, Flag sign, const Round round, const Tininess tininess) {
   Sint16 a_exp = float64_exp(a);
   Sint16 b_exp = float64_exp(b);
   Uint64 a_sig = float64_fract(a) << 9;
@@ -151,10 +174,10 @@ static Float64 float64_add_sig(Context *ctx, Float64 a, Float64 b, Flag sign) {
     exp++;
   }
 round_and_pack:
-  return float64_round_and_pack(ctx, sign, exp, sig);
+  return round_and_pack(ctx, sign, exp, sig, round, tininess);
 }
 
-static Float64 float64_sub_sig(Context *ctx, Float64 a, Float64 b, Flag sign) {
+INLINE Float64 sub_sig(Context *ctx, Float64 a, Float64 b, Flag sign, const Round round, const Tininess tininess) {
   Sint16 a_exp = float64_exp(a);
   Sint16 b_exp = float64_exp(b);
   Uint64 a_sig = float64_fract(a) << 10;
@@ -187,12 +210,12 @@ static Float64 float64_sub_sig(Context *ctx, Float64 a, Float64 b, Flag sign) {
   if (a_sig < b_sig) {
     goto b_bigger;
   }
-  return float64_pack(ctx->round == ROUND_DOWN, 0, 0);
+  return float64_pack(round == ROUND_DOWN, 0, 0);
 b_exp_bigger:
   if (b_exp == 0x7ff) {
     return b_sig
       ? float64_propagate_nan(ctx, a, b)
-      : float64_pack(sign ^ 1, 0xff, 0);
+      : float64_pack(sign ^ 1, 0x7ff, 0);
   }
   if (a_exp == 0) {
     exp_diff++;
@@ -222,26 +245,26 @@ a_bigger:
   exp = a_exp;
 normalize_round_and_pack:
   exp--;
-  return float64_normalize_round_and_pack(ctx, sign, exp, sig);
+  return normalize_round_and_pack(ctx, sign, exp, sig, round, tininess);
 }
 
-Float64 float64_add(Context *ctx, Float64 a, Float64 b) {
+INLINE Float64 add(Context *ctx, Float64 a, Float64 b, const Round round, const Tininess tininess) {
   const Flag a_sign = float64_sign(a);
   const Flag b_sign = float64_sign(b);
   return a_sign == b_sign
-    ? float64_add_sig(ctx, a, b, a_sign)
-    : float64_sub_sig(ctx, a, b, b_sign);
+    ? add_sig(ctx, a, b, a_sign, round, tininess)
+    : sub_sig(ctx, a, b, a_sign, round, tininess);
 }
 
-Float64 float64_sub(Context *ctx, Float64 a, Float64 b) {
+INLINE Float64 sub(Context *ctx, Float64 a, Float64 b, const Round round, const Tininess tininess) {
   const Flag a_sign = float64_sign(a);
   const Flag b_sign = float64_sign(b);
   return a_sign == b_sign
-    ? float64_sub_sig(ctx, a, b, a_sign)
-    : float64_add_sig(ctx, a, b, a_sign);
+    ? sub_sig(ctx, a, b, a_sign, round, tininess)
+    : add_sig(ctx, a, b, a_sign, round, tininess);
 }
 
-Float64 float64_mul(Context *ctx, Float64 a, Float64 b) {
+INLINE Float64 mul(Context *ctx, Float64 a, Float64 b, const Round round, const Tininess tininess) {
   Sint16 a_exp = float64_exp(a);
   Sint16 b_exp = float64_exp(b);
   Uint64 a_sig = float64_fract(a);
@@ -280,10 +303,10 @@ Float64 float64_mul(Context *ctx, Float64 a, Float64 b) {
   if (b_exp == 0) {
     if (b_sig == 0) {
       return float64_pack(sign, 0, 0);
-      const Normal64 n = float64_normalize_subnormal(b_sig);
-      b_exp = n.exp;
-      b_sig = n.sig;
     }
+    const Normal64 n = float64_normalize_subnormal(b_sig);
+    b_exp = n.exp;
+    b_sig = n.sig;
   }
   Sint16 exp = a_exp + b_exp - 0x3ff;
   a_sig = (a_sig | LIT64(0x0010000000000000)) << 10;
@@ -296,10 +319,10 @@ Float64 float64_mul(Context *ctx, Float64 a, Float64 b) {
     mul.z0 <<= 1;
     exp--;
   }
-  return float64_round_and_pack(ctx, sign, exp, mul.z0);
+  return round_and_pack(ctx, sign, exp, mul.z0, round, tininess);
 }
 
-Float64 float64_div(Context *ctx, Float64 a, Float64 b) {
+INLINE Float64 div(Context *ctx, Float64 a, Float64 b, const Round round, const Tininess tininess) {
   Sint16 a_exp = float64_exp(a);
   Sint16 b_exp = float64_exp(b);
   Uint64 a_sig = float64_fract(a);
@@ -318,7 +341,7 @@ Float64 float64_div(Context *ctx, Float64 a, Float64 b) {
       context_raise(ctx, EXCEPTION_INVALID);
       return FLOAT64_NAN;
     }
-    return float64_pack(sign, 0xff, 0);
+    return float64_pack(sign, 0x7ff, 0);
   }
   if (b_exp == 0x7ff) {
     return b_sig
@@ -332,7 +355,7 @@ Float64 float64_div(Context *ctx, Float64 a, Float64 b) {
         return FLOAT64_NAN;
       }
       context_raise(ctx, EXCEPTION_INFINITE);
-      return float64_pack(sign, 0xff, 0);
+      return float64_pack(sign, 0x7ff, 0);
     }
     const Normal64 n = float64_normalize_subnormal(b_sig);
     b_exp = n.exp;
@@ -346,7 +369,7 @@ Float64 float64_div(Context *ctx, Float64 a, Float64 b) {
     a_exp = n.exp;
     a_sig = n.sig;
   }
-  Sint16 exp = a_exp - b_exp + 0x7d;
+  Sint16 exp = a_exp - b_exp + 0x3fd;
   a_sig = (a_sig | LIT64(0x0010000000000000)) << 10;
   b_sig = (b_sig | LIT64(0x0010000000000000)) << 11;
   if (b_sig <= a_sig + a_sig) {
@@ -365,5 +388,230 @@ Float64 float64_div(Context *ctx, Float64 a, Float64 b) {
     sig |= rem.z1 != 0;
   }
 
-  return float64_round_and_pack(ctx, sign, exp, sig);
-}
\ No newline at end of file
+  return round_and_pack(ctx, sign, exp, sig, round, tininess);
+}
+
+// The product is exact in 128 bits, the addend is aligned to it and only the
+// sum is rounded.
+INLINE Float64 mul_add(Context *ctx, Float64 a, Float64 b, Float64 c, const Round round, const Tininess tininess) {
+  Sint32 a_exp = float64_exp(a);
+  Sint32 b_exp = float64_exp(b);
+  Sint32 c_exp = float64_exp(c);
+  Uint64 a_sig = float64_fract(a);
+  Uint64 b_sig = float64_fract(b);
+  Uint64 c_sig = float64_fract(c);
+  const Flag c_sign = float64_sign(c);
+  const Flag sign = float64_sign(a) ^ float64_sign(b);
+  const Flag a_zero = (a_exp | a_sig) == 0;
+  const Flag b_zero = (b_exp | b_sig) == 0;
+  const Flag c_zero = (c_exp | c_sig) == 0;
+  if (float64_is_any_nan(a) || float64_is_any_nan(b) || float64_is_any_nan(c)) {
+    return float64_propagate_nan3(ctx, a, b, c);
+  }
+  if (a_exp == 0x7ff || b_exp == 0x7ff) {
+    // Infinity times zero, or an infinite product and addend of opposite sign.
+    if (a_zero || b_zero || (c_exp == 0x7ff && c_sign != sign)) {
+      context_raise(ctx, EXCEPTION_INVALID);
+      return FLOAT64_NAN;
+    }
+    return float64_pack(sign, 0x7ff, 0);
+  }
+  if (c_exp == 0x7ff) {
+    return c;
+  }
+  if (a_zero || b_zero) {
+    // Zeros of opposite sign sum to zero with the sign of the rounding mode.
+    if (c_zero && c_sign != sign) {
+      return float64_pack(round == ROUND_DOWN, 0, 0);
+    }
+    return c;
+  }
+
+  if (a_exp == 0) {
+    const Normal64 n = float64_normalize_subnormal(a_sig);
+    a_exp = n.exp;
+    a_sig = n.sig;
+  }
+  if (b_exp == 0) {
+    const Normal64 n = float64_normalize_subnormal(b_sig);
+    b_exp = n.exp;
+    b_sig = n.sig;
+  }
+
+  // The product has 106 bits, placed below bit 126 so the sum cannot carry out.
+  Uint128 sig = uint128_shl(
+    uint128_mul64x64(a_sig | LIT64(0x0010000000000000), b_sig | LIT64(0x0010000000000000)),
+    20);
+  Sint32 exp = a_exp + b_exp - 0x87a;
+  Flag r_sign = sign;
+
+  if (!c_zero) {
+    if (c_exp == 0) {
+      const Normal64 n = float64_normalize_subnormal(c_sig);
+      c_exp = n.exp;
+      c_sig = n.sig;
+    }
+    Uint128 addend = uint128_shl((Uint128){0, c_sig | LIT64(0x0010000000000000)}, 73);
+    Sint32 addend_exp = c_exp - 0x47c;
+    // Only the operand with the smaller exponent loses bits to the alignment,
+    // and only when it is too small for the sum to need them.
+    if (exp < addend_exp) {
+      sig = uint128_rshr(sig, addend_exp - exp < 128 ? addend_exp - exp : 128);
+      exp = addend_exp;
+    } else {
+      addend = uint128_rshr(addend, exp - addend_exp < 128 ? exp - addend_exp : 128);
+    }
+    if (sign == c_sign) {
+      sig = uint128_add(sig, addend);
+    } else if (!uint128_lt(sig, addend)) {
+      sig = uint128_sub(sig, addend);
+    } else {
+      sig = uint128_sub(addend, sig);
+      r_sign = c_sign;
+    }
+    if ((sig.z0 | sig.z1) == 0) {
+      return float64_pack(round == ROUND_DOWN, 0, 0);
+    }
+  }
+
+  const Sint16 shift = uint128_clz(sig) - 1;
+  sig = uint128_shl(sig, shift);
+  exp -= shift;
+  return round_and_pack(ctx, r_sign, exp + 0x47c, sig.z0 | (sig.z1 != 0), round, tininess);
+}
+
+#define SPECIALIZE(suffix, round, tininess) \
+  static Float64 round_and_pack_##suffix(Context *ctx, Flag sign, Sint32 exp, Uint64 sig) { \
+    return round_and_pack(ctx, sign, exp, sig, round, tininess); \
+  } \
+  static Float64 add_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return add(ctx, a, b, round, tininess); \
+  } \
+  static Float64 sub_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return sub(ctx, a, b, round, tininess); \
+  } \
+  static Float64 mul_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return mul(ctx, a, b, round, tininess); \
+  } \
+  static Float64 div_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return div(ctx, a, b, round, tininess); \
+  } \
+  static Float64 fma_##suffix(Context *ctx, Float64 a, Float64 b, Float64 c) { \
+    return mul_add(ctx, a, b, c, round, tininess); \
+  } \
+  static const Float64Ops OPS_##suffix = { \
+    round_and_pack_##suffix, \
+    add_##suffix, \
+    sub_##suffix, \
+    mul_##suffix, \
+    div_##suffix, \
+    fma_##suffix \
+  };
+
+SPECIALIZE(nearest_even_after, ROUND_NEAREST_EVEN, TININESS_AFTER_ROUNDING)
+SPECIALIZE(nearest_even_before, ROUND_NEAREST_EVEN, TININESS_BEFORE_ROUNDING)
+SPECIALIZE(to_zero_after, ROUND_TO_ZERO, TININESS_AFTER_ROUNDING)
+SPECIALIZE(to_zero_before, ROUND_TO_ZERO, TININESS_BEFORE_ROUNDING)
+SPECIALIZE(down_after, ROUND_DOWN, TININESS_AFTER_ROUNDING)
+SPECIALIZE(down_before, ROUND_DOWN, TININESS_BEFORE_ROUNDING)
+SPECIALIZE(up_after, ROUND_UP, TININESS_AFTER_ROUNDING)
+SPECIALIZE(up_before, ROUND_UP, TININESS_BEFORE_ROUNDING)
+
+// Indexed by Round then Tininess.
+static const Float64Ops *const OPS[4][2] = {
+  { &OPS_nearest_even_after, &OPS_nearest_even_before },
+  { &OPS_to_zero_after,      &OPS_to_zero_before      },
+  { &OPS_down_after,         &OPS_down_before         },
+  { &OPS_up_after,           &OPS_up_before           }
+};
+
+const Float64Ops *float64_ops(Round round, Tininess tininess) {
+  return OPS[round][tininess];
+}
+
+Float64 float64_round_and_pack(Context *ctx, Flag sign, Sint32 exp, Uint64 sig) {
+  return ctx->float64->round_and_pack(ctx, sign, exp, sig);
+}
+
+// Counts an operation with operands [a] and [b] and result [r] in the stats of
+// the context.
+static inline Float64 counted(Context *ctx, Size operation, Float64 a, Float64 b, Float64 r) {
+  STATS(ctx, operations[operation], 1);
+  STATS(ctx, subnormal_inputs, float64_is_subnormal(a) + float64_is_subnormal(b));
+  STATS(ctx, subnormal_outputs, float64_is_subnormal(r));
+  return r;
+}
+
+Float64 float64_add(Context *ctx, Float64 a, Float64 b) {
+  return counted(ctx, STATS_ADD, a, b, ctx->float64->add(ctx, a, b));
+}
+
+Float64 float64_sub(Context *ctx, Float64 a, Float64 b) {
+  return counted(ctx, STATS_SUB, a, b, ctx->float64->sub(ctx, a, b));
+}
+
+Float64 float64_mul(Context *ctx, Float64 a, Float64 b) {
+  return counted(ctx, STATS_MUL, a, b, ctx->float64->mul(ctx, a, b));
+}
+
+Float64 float64_div(Context *ctx, Float64 a, Float64 b) {
+  return counted(ctx, STATS_DIV, a, b, ctx->float64->div(ctx, a, b));
+}
+
+Float64 float64_fma(Context *ctx, Float64 a, Float64 b, Float64 c) {
+  STATS(ctx, subnormal_inputs, float64_is_subnormal(c));
+  return counted(ctx, STATS_FMA, a, b, ctx->float64->fma(ctx, a, b, c));
+}
+
+// Every integer conversion goes through the magnitude as a 64-bit integer.
+static Float64 from_integer(Context *ctx, Flag sign, Uint64 a) {
+  STATS(ctx, operations[STATS_CONVERT], 1);
+  if (a == 0) {
+    return FLOAT64_ZERO;
+  }
+  const Sint8 shift = count_leading_zeros_u64(a);
+  return float64_round_and_pack(ctx, sign, 0x43d - shift, rshr64(a << shift, 1));
+}
+
+Float64 float64_from_sint32(Context *ctx, Sint32 a) {
+  return from_integer(ctx, a < 0, a < 0 ? -(Uint64)a : (Uint64)a);
+}
+
+Float64 float64_from_uint32(Context *ctx, Uint32 a) {
+  return from_integer(ctx, 0, a);
+}
+
+Float64 float64_from_sint64(Context *ctx, Sint64 a) {
+  return from_integer(ctx, a < 0, a < 0 ? -(Uint64)a : (Uint64)a);
+}
+
+Float64 float64_from_uint64(Context *ctx, Uint64 a) {
+  return from_integer(ctx, 0, a);
+}
+
+static Uint64 to_integer(Context *ctx, Float64 a, Uint64 max_positive, Uint64 max_negative, Uint64 invalid) {
+  STATS(ctx, operations[STATS_CONVERT], 1);
+  Uint8 raised;
+  const Uint64 r = float64_to_integer(a, ctx->config.round, max_positive, max_negative, invalid, &raised);
+  if (raised) {
+    ctx->roundings += raised == EXCEPTION_INEXACT;
+    context_raise(ctx, raised);
+  }
+  return r;
+}
+
+Sint32 float64_to_sint32(Context *ctx, Float64 a) {
+  return (Uint32)to_integer(ctx, a, LIT64(0x7fffffff), LIT64(0x80000000), LIT64(0x80000000));
+}
+
+Uint32 float64_to_uint32(Context *ctx, Float64 a) {
+  return to_integer(ctx, a, LIT64(0xffffffff), 0, LIT64(0xffffffff));
+}
+
+Sint64 float64_to_sint64(Context *ctx, Float64 a) {
+  return to_integer(ctx, a, LIT64(0x7fffffffffffffff), LIT64(0x8000000000000000), LIT64(0x8000000000000000));
+}
+
+Uint64 float64_to_uint64(Context *ctx, Float64 a) {
+  return to_integer(ctx, a, LIT64(0xffffffffffffffff), 0, LIT64(0xffffffffffffffff));
+}
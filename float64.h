@@ -23,6 +23,14 @@ static inline Flag float64_is_snan(Float64 a) {
     && (a.bits & LIT64(0x0007ffffffffffff));
 }
 
+static inline Flag float64_is_any_nan(Float64 a) {
+  return (a.bits & LIT64(0x7fffffffffffffff)) > LIT64(0x7ff0000000000000);
+}
+
+static inline Flag float64_is_subnormal(Float64 a) {
+  return float64_exp(a) == 0 && float64_fract(a) != 0;
+}
+
 // Pack sign, exponent, and significant into double-precision float.
 static inline Float64 float64_pack(Flag sign, Sint16 exp, Uint64 sig) {
   return (Float64){(((Uint64)sign) << 63) + (((Uint64)exp) << 52) + sig};
@@ -32,9 +40,14 @@ static inline Float64 float64_pack(Flag sign, Sint16 exp, Uint64 sig) {
 static const Float64 FLOAT64_NAN = {LIT64(0xffffffffffffffff)};
 static const Float64 FLOAT64_ZERO = {0}; // 0x0p+0
 
-// Conversion of float32 NaN to CanonicalNaN format.
+// Conversion of float64 NaN to CanonicalNaN format.
 CanonicalNaN float64_to_canonical_nan(Context*, Float64);
 
+// Conversion of CanonicalNaN format to float64 NaN.
+static inline Float64 canonical_nan_to_float64(CanonicalNaN nan) {
+  return (Float64){(((Uint64)nan.sign) << 63) | LIT64(0x7FF8000000000000) | (nan.hi >> 12)};
+}
+
 // Normalize subnormal.
 Normal64 float64_normalize_subnormal(Uint64 sig);
 
@@ -46,6 +59,30 @@ Float64 float64_add(Context*, Float64, Float64); // a + b
 Float64 float64_sub(Context*, Float64, Float64); // a - b
 Float64 float64_mul(Context*, Float64, Float64); // a * b
 Float64 float64_div(Context*, Float64, Float64); // a / b
+Float64 float64_fma(Context*, Float64, Float64, Float64); // a * b + c, rounded once
+
+// Conversion functions, the same as for float32.
+Float64 float64_from_sint32(Context*, Sint32);
+Float64 float64_from_uint32(Context*, Uint32);
+Float64 float64_from_sint64(Context*, Sint64);
+Float64 float64_from_uint64(Context*, Uint64);
+Sint32 float64_to_sint32(Context*, Float64);
+Uint32 float64_to_uint32(Context*, Float64);
+Sint64 float64_to_sint64(Context*, Float64);
+Uint64 float64_to_uint64(Context*, Float64);
+
+// The conversions to integers without a context, see integer_round_and_pack.
+static inline Uint64 float64_to_integer(Float64 a, Round round, Uint64 max_positive, Uint64 max_negative, Uint64 invalid, Uint8 *raised) {
+  const Sint16 a_exp = float64_exp(a);
+  const Uint64 a_sig = a_exp ? float64_fract(a) | LIT64(0x0010000000000000) : float64_fract(a);
+  const Sint32 count = 0x433 - (a_exp ? a_exp : 1);
+  if (a_exp == 0x7ff || count < -11) {
+    return integer_round_and_pack(round, 0, 0, -1, max_positive, max_negative, invalid, raised);
+  }
+  return count < 0
+    ? integer_round_and_pack(round, float64_sign(a), a_sig << -count, 0, max_positive, max_negative, invalid, raised)
+    : integer_round_and_pack(round, float64_sign(a), a_sig, count, max_positive, max_negative, invalid, raised);
+}
 
 // Needed temporarily for printing.
 static inline double float64_cast(Float64 x) {
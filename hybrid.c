@@ -0,0 +1,312 @@
+#include <fenv.h> // fegetround
+#include <float.h> // FLT_EVAL_METHOD, DBL_MANT_DIG
+
+#include "hybrid.h"
+#include "float32.h"
+#include "float64.h"
+
+#if defined(FE_TONEAREST) && FLT_EVAL_METHOD == 0 && DBL_MANT_DIG == 53
+
+// Everything here is inlined into the specializations below with constant
+// operation and rounding mode, like the soft-float functions are.
+#define INLINE static inline __attribute__((always_inline))
+
+// The host is left in round to nearest even and its exception flags are never
+// touched, changing either for every operation costs more than the soft-float
+// functions do. Instead the host result is rounded to nearest and the sign of
+// its residual, the exact result minus the host result, is found with an error
+// free transformation. That is enough to round in any direction and to know if
+// the result is inexact.
+
+INLINE int sign_of(double x) {
+  return (x > 0) - (x < 0);
+}
+
+// The exact a + b is s + two_sum_error(a, b, s) for s = a + b.
+INLINE double two_sum_error(double a, double b, double s) {
+  const double bb = s - a;
+  return (a - (s - bb)) + (b - bb);
+}
+
+// The exact a * b is p + two_product_error(a, b, p) for p = a * b, as long as
+// neither a nor b is beyond 2^996 in magnitude and the error does not
+// underflow.
+INLINE double two_product_error(double a, double b, double p) {
+#if defined(__FP_FAST_FMA)
+  return __builtin_fma(a, b, -p);
+#else
+  const double ca = 134217729.0 * a; // 2^27 + 1
+  const double a_hi = ca - (ca - a);
+  const double a_lo = a - a_hi;
+  const double cb = 134217729.0 * b;
+  const double b_hi = cb - (cb - b);
+  const double b_lo = b - b_hi;
+  return ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+#endif
+}
+
+// Single-precision is computed in double-precision, which has more than twice
+// the precision plus two bits, so rounding the double-precision result again to
+// single-precision gives the correctly rounded result. The residual of that is
+// exact in double-precision for every operation.
+INLINE float host32(float a, float b, Operation operation, int *residual) {
+  const double x = a;
+  const double y = b;
+  switch (operation) {
+  case OPERATION_ADD: // fallthrough
+  case OPERATION_SUB: {
+    const double yy = operation == OPERATION_ADD ? y : -y;
+    const double s = x + yy;
+    const float r = s;
+    *residual = sign_of((s - r) + two_sum_error(x, yy, s));
+    return r;
+  }
+  case OPERATION_MUL: {
+    const double p = x * y;
+    const float r = p;
+    *residual = sign_of(p - r);
+    return r;
+  }
+  case OPERATION_DIV: {
+    const float r = x / y;
+    *residual = sign_of(x - r * y) * sign_of(y);
+    return r;
+  }
+  default: // OPERATION_FMA and the kernels
+    break;
+  }
+  return 0;
+}
+
+INLINE double host64(double x, double y, Operation operation, int *residual) {
+  switch (operation) {
+  case OPERATION_ADD: // fallthrough
+  case OPERATION_SUB: {
+    const double yy = operation == OPERATION_ADD ? y : -y;
+    const double s = x + yy;
+    *residual = sign_of(two_sum_error(x, yy, s));
+    return s;
+  }
+  case OPERATION_MUL: {
+    const double p = x * y;
+    *residual = sign_of(two_product_error(x, y, p));
+    return p;
+  }
+  case OPERATION_DIV: {
+    const double q = x / y;
+    const double p = q * y;
+    *residual = sign_of((x - p) - two_product_error(q, y, p)) * sign_of(y);
+    return q;
+  }
+  default: // OPERATION_FMA and the kernels
+    break;
+  }
+  return 0;
+}
+
+// Picks one in HYBRID_CHECK_RATE results to check with a xorshift over the seed
+// of the context.
+INLINE Bool sample(Context *ctx) {
+  Uint32 x = ctx->seed;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  ctx->seed = x;
+  return x % HYBRID_CHECK_RATE == 0;
+}
+
+// Raise what the soft-float function raised in [scratch] in [ctx] instead. A
+// single operation raises underflow on its own before anything else, so that
+// is the one record split off the sticky flags.
+static void replay(Context *ctx, const Context *scratch) {
+  const Exception underflow = scratch->raised & EXCEPTION_UNDERFLOW;
+  if (underflow) {
+    context_raise(ctx, underflow);
+  }
+  if (scratch->raised & ~underflow) {
+    context_raise(ctx, scratch->raised & ~underflow);
+  }
+  ctx->roundings += scratch->roundings;
+}
+
+// Operands are only given to the host when both are normal and within [range]
+// binades of one, which for double-precision keeps the error free
+// transformations exact. Results are only taken from it when they are normal
+// and not in the first binade either, since those may have been tiny before
+// they were rounded, which only the soft-float functions detect.
+//
+// A nearest result is moved one ULP towards the exact result, by stepping its
+// bit pattern, when the rounding mode asks for that.
+#define HYBRID(name, Type, Host, Bits, Ops, ops, host, exp, max, range) \
+  static Type soft_##name(Context *ctx, Type a, Type b, Operation operation) { \
+    const Ops *soft = ops(ctx->config.round, ctx->config.tininess); \
+    switch (operation) { \
+    case OPERATION_ADD: return soft->add(ctx, a, b); \
+    case OPERATION_SUB: return soft->sub(ctx, a, b); \
+    case OPERATION_MUL: return soft->mul(ctx, a, b); \
+    case OPERATION_DIV: return soft->div(ctx, a, b); \
+    default: break; \
+    } \
+    return a; \
+  } \
+  INLINE Type name(Context *ctx, Type a, Type b, Operation operation, const Round round, const Bool check) { \
+    const Sint16 a_exp = exp(a); \
+    const Sint16 b_exp = exp(b); \
+    if (a_exp == 0 || a_exp == (max) || b_exp == 0 || b_exp == (max) \
+      || a_exp - (max) / 2 > (range) || (max) / 2 - a_exp > (range) \
+      || b_exp - (max) / 2 > (range) || (max) / 2 - b_exp > (range)) \
+    { \
+      return soft_##name(ctx, a, b, operation); \
+    } \
+    union { Type s; Host h; } x = {a}, y = {b}, z; \
+    int residual; \
+    z.h = host(x.h, y.h, operation, &residual); \
+    Type r = z.s; \
+    if (exp(r) == (max)) { \
+      return soft_##name(ctx, a, b, operation); \
+    } \
+    const Flag sign = r.bits >> (sizeof(Bits) * 8 - 1); \
+    if (residual) { \
+      switch (round) { \
+      case ROUND_NEAREST_EVEN: \
+        break; \
+      case ROUND_TO_ZERO: \
+        r.bits -= (residual > 0) == sign; \
+        break; \
+      case ROUND_DOWN: \
+        r.bits += residual < 0 ? (sign ? 1 : -1) : 0; \
+        break; \
+      case ROUND_UP: \
+        r.bits += residual > 0 ? (sign ? -1 : 1) : 0; \
+        break; \
+      } \
+    } \
+    if (exp(r) < 2 || exp(r) == (max)) { \
+      return soft_##name(ctx, a, b, operation); \
+    } \
+    if (check && sample(ctx)) { \
+      Context scratch; \
+      context_copy(&scratch, ctx); \
+      const Type s = soft_##name(&scratch, a, b, operation); \
+      ctx->checks++; \
+      if (s.bits != r.bits \
+        || scratch.raised != (residual ? EXCEPTION_INEXACT : 0) \
+        || scratch.roundings != (residual ? 1u : 0u)) \
+      { \
+        ctx->mismatches++; \
+        replay(ctx, &scratch); \
+        context_free(&scratch); \
+        return s; \
+      } \
+      context_free(&scratch); \
+    } \
+    if (residual) { \
+      ctx->roundings++; \
+      STATS(ctx, rounded[(residual < 0) ^ (r.bits != z.s.bits)], 1); \
+      context_raise(ctx, EXCEPTION_INEXACT); \
+    } \
+    return r; \
+  }
+
+HYBRID(hybrid32, Float32, float, Uint32, Float32Ops, float32_ops, host32, float32_exp, 0xff, 0xff)
+HYBRID(hybrid64, Float64, double, Uint64, Float64Ops, float64_ops, host64, float64_exp, 0x7ff, 448)
+
+// Rounding a significand and fused multiply-add are never done by the host.
+static Float32 round_and_pack32(Context *ctx, Flag sign, Sint32 exp, Uint32 sig) {
+  return float32_ops(ctx->config.round, ctx->config.tininess)->round_and_pack(ctx, sign, exp, sig);
+}
+
+static Float64 round_and_pack64(Context *ctx, Flag sign, Sint32 exp, Uint64 sig) {
+  return float64_ops(ctx->config.round, ctx->config.tininess)->round_and_pack(ctx, sign, exp, sig);
+}
+
+static Float32 fma32(Context *ctx, Float32 a, Float32 b, Float32 c) {
+  return float32_ops(ctx->config.round, ctx->config.tininess)->fma(ctx, a, b, c);
+}
+
+static Float64 fma64(Context *ctx, Float64 a, Float64 b, Float64 c) {
+  return float64_ops(ctx->config.round, ctx->config.tininess)->fma(ctx, a, b, c);
+}
+
+#define SPECIALIZE(suffix, round, check) \
+  static Float32 add32_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return hybrid32(ctx, a, b, OPERATION_ADD, round, check); \
+  } \
+  static Float32 sub32_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return hybrid32(ctx, a, b, OPERATION_SUB, round, check); \
+  } \
+  static Float32 mul32_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return hybrid32(ctx, a, b, OPERATION_MUL, round, check); \
+  } \
+  static Float32 div32_##suffix(Context *ctx, Float32 a, Float32 b) { \
+    return hybrid32(ctx, a, b, OPERATION_DIV, round, check); \
+  } \
+  static Float64 add64_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return hybrid64(ctx, a, b, OPERATION_ADD, round, check); \
+  } \
+  static Float64 sub64_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return hybrid64(ctx, a, b, OPERATION_SUB, round, check); \
+  } \
+  static Float64 mul64_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return hybrid64(ctx, a, b, OPERATION_MUL, round, check); \
+  } \
+  static Float64 div64_##suffix(Context *ctx, Float64 a, Float64 b) { \
+    return hybrid64(ctx, a, b, OPERATION_DIV, round, check); \
+  } \
+  static const Float32Ops OPS32_##suffix = { \
+    round_and_pack32, add32_##suffix, sub32_##suffix, mul32_##suffix, div32_##suffix, fma32 \
+  }; \
+  static const Float64Ops OPS64_##suffix = { \
+    round_and_pack64, add64_##suffix, sub64_##suffix, mul64_##suffix, div64_##suffix, fma64 \
+  };
+
+SPECIALIZE(nearest_even, ROUND_NEAREST_EVEN, false)
+SPECIALIZE(to_zero, ROUND_TO_ZERO, false)
+SPECIALIZE(down, ROUND_DOWN, false)
+SPECIALIZE(up, ROUND_UP, false)
+SPECIALIZE(nearest_even_check, ROUND_NEAREST_EVEN, true)
+SPECIALIZE(to_zero_check, ROUND_TO_ZERO, true)
+SPECIALIZE(down_check, ROUND_DOWN, true)
+SPECIALIZE(up_check, ROUND_UP, true)
+
+// Indexed by check then Round.
+static const Float32Ops *const OPS32[2][4] = {
+  { &OPS32_nearest_even,       &OPS32_to_zero,       &OPS32_down,       &OPS32_up       },
+  { &OPS32_nearest_even_check, &OPS32_to_zero_check, &OPS32_down_check, &OPS32_up_check }
+};
+
+static const Float64Ops *const OPS64[2][4] = {
+  { &OPS64_nearest_even,       &OPS64_to_zero,       &OPS64_down,       &OPS64_up       },
+  { &OPS64_nearest_even_check, &OPS64_to_zero_check, &OPS64_down_check, &OPS64_up_check }
+};
+
+// The tininess mode is only needed by the soft-float functions, which are
+// picked from the context when falling back to them. A host that is not in
+// round to nearest even, as it is by default, is not used at all.
+const Float32Ops *float32_hybrid_ops(Round round, Tininess tininess, Bool check) {
+  if (fegetround() != FE_TONEAREST) {
+    return float32_ops(round, tininess);
+  }
+  return OPS32[check][round];
+}
+
+const Float64Ops *float64_hybrid_ops(Round round, Tininess tininess, Bool check) {
+  if (fegetround() != FE_TONEAREST) {
+    return float64_ops(round, tininess);
+  }
+  return OPS64[check][round];
+}
+
+#else
+
+const Float32Ops *float32_hybrid_ops(Round round, Tininess tininess, Bool check) {
+  (void)check;
+  return float32_ops(round, tininess);
+}
+
+const Float64Ops *float64_hybrid_ops(Round round, Tininess tininess, Bool check) {
+  (void)check;
+  return float64_ops(round, tininess);
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef HYBRID_H
+#define HYBRID_H
+#include "soft.h"
+
+// Arithmetic that uses the host floating-point unit where it provably agrees
+// with the soft-float functions and falls back to them everywhere else.
+//
+// The host is only used when both operands are normal and it produces a result
+// that is normal, away from the subnormal range, with no exception other than
+// inexact, so subnormals, NaN payloads, overflow, underflow and tininess
+// detection are always left to the soft-float functions. The results, the
+// exceptions raised and the roundings counted are the same as theirs.
+//
+// With [check] set, one in every HYBRID_CHECK_RATE results taken from the host,
+// picked at random, is recomputed with the soft-float functions and compared.
+// Every comparison is counted in [checks], every disagreement in [mismatches]
+// of the context, and the soft-float result is used when they disagree.
+//
+// On hosts where the rounding mode cannot be controlled, or where float and
+// double arithmetic is evaluated in a wider format, these are the soft-float
+// functions.
+#define HYBRID_CHECK_RATE 16
+
+const Float32Ops *float32_hybrid_ops(Round, Tininess, Bool check);
+const Float64Ops *float64_hybrid_ops(Round, Tininess, Bool check);
+
+#endif // HYBRID_H
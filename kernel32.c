@@ -10,7 +10,7 @@ static inline void float32_force_eval(Float32 x) {
   (void)y; // Mark as used.
 }
 
-Float32 float32_floor(Context *ctx, Float32 x) {
+static Float32 floor_untrapped(Context *ctx, Float32 x) {
   const Sint16 e = float32_exp(x) - 0x7f;
   if (e >= 23) {
     return x;
@@ -20,13 +20,13 @@ Float32 float32_floor(Context *ctx, Float32 x) {
     if ((x.bits & m) == 0) {
       return x;
     }
-    float32_force_eval(float32_add(ctx, x, HUGE)); 
+    float32_force_eval(float32_add_untrapped(ctx, x, HUGE)); 
     if (x.bits >> 31) {
       x.bits += m;
     }
     x.bits &= ~m;
   } else {
-    float32_force_eval(float32_add(ctx, x, HUGE));
+    float32_force_eval(float32_add_untrapped(ctx, x, HUGE));
     if (x.bits >> 31 == 0) {
       x.bits = 0;
     } else if (x.bits << 1) {
@@ -36,7 +36,7 @@ Float32 float32_floor(Context *ctx, Float32 x) {
   return x;
 }
 
-Float32 float32_ceil(Context *ctx, Float32 x) {
+static Float32 ceil_untrapped(Context *ctx, Float32 x) {
   const Sint16 e = float32_exp(x) - 0x7f;
   if (e >= 23) {
     return x;
@@ -46,13 +46,13 @@ Float32 float32_ceil(Context *ctx, Float32 x) {
     if ((x.bits & m) == 0) {
       return x;
     }
-    float32_force_eval(float32_add(ctx, x, HUGE));
+    float32_force_eval(float32_add_untrapped(ctx, x, HUGE));
     if (x.bits >> 31 == 0) {
       x.bits += m;
     }
     x.bits &= ~m;
   } else {
-    float32_force_eval(float32_add(ctx, x, HUGE));
+    float32_force_eval(float32_add_untrapped(ctx, x, HUGE));
     if (x.bits >> 31) {
       x.bits = LIT32(0x80000000); // -0.0
     } else if (x.bits << 1) {
@@ -62,7 +62,7 @@ Float32 float32_ceil(Context *ctx, Float32 x) {
   return x;
 }
 
-Float32 float32_trunc(Context *ctx, Float32 x) {
+static Float32 trunc_untrapped(Context *ctx, Float32 x) {
   Sint16 e = float32_exp(x) - 0x7f + 9;
   if (e >= 23 + 9) {
     return x;
@@ -74,7 +74,7 @@ Float32 float32_trunc(Context *ctx, Float32 x) {
   if ((x.bits & m) == 0) {
     return x;
   }
-  float32_force_eval(float32_add(ctx, x, HUGE));
+  float32_force_eval(float32_add_untrapped(ctx, x, HUGE));
   x.bits &= ~m;
   return x;
 }
@@ -87,11 +87,12 @@ static inline Uint32 mul32(Uint32 a, Uint32 b) {
 // Computes (x-x) / (x-x) to correctly raise an invalid exception and compute
 // correct exceptional value of NaN, sNaN, +Inf, or -Inf for given x.
 static Float32 float32_invalid(Context *ctx, Float32 x) {
-  const Float32 sub = float32_sub(ctx, x, x);
-  return float32_div(ctx, sub, sub);
+  const Float32 sub = float32_sub_untrapped(ctx, x, x);
+  return float32_div_untrapped(ctx, sub, sub);
 }
 
-Float32 float32_sqrt(Context *ctx, Float32 x) {
+static Float32 sqrt_untrapped(Context *ctx, Float32 x) {
+  STATS(ctx, operations[STATS_SQRT], 1);
   // if x in [1,2): i = (Sint32)(64*x);
   // if x in [2,4): i = (Sint32)(32*x-64);
   // TABLE[i]*2^-16 is estimating 1/sqrt(x) with small relative error:
@@ -129,7 +130,7 @@ Float32 float32_sqrt(Context *ctx, Float32 x) {
       return float32_invalid(ctx, x);
     }
     // is subnormal, normalize it.
-    const Float32 n = float32_mul(ctx, x, (Float32){LIT32(0x4b000000)}); // 0x1p23f
+    const Float32 n = float32_mul_untrapped(ctx, x, (Float32){LIT32(0x4b000000)}); // 0x1p23f
     ix = n.bits;
     ix -= 23 << 23;
   }
@@ -179,7 +180,32 @@ Float32 float32_sqrt(Context *ctx, Float32 x) {
   // Handle rounding and inexact exceptions.
   const Float32 t = {(d2 == 0 ? 0 : LIT32(0x01000000)) | ((d1 ^ d2) & LIT32(0x80000000))};
 
-  return float32_add(ctx, y, t);
+  return float32_add_untrapped(ctx, y, t);
+}
+
+// What a kernel raised traps once, as [operation] of [x] giving [r].
+static inline Float32 trapped(Context *ctx, Operation operation, Float32 x, Float32 r) {
+  return ctx->trapped ? context_trap(ctx, operation, x, FLOAT32_ZERO, FLOAT32_ZERO, r) : r;
+}
+
+Float32 float32_floor(Context *ctx, Float32 x) {
+  ctx->trapped = 0;
+  return trapped(ctx, OPERATION_FLOOR, x, floor_untrapped(ctx, x));
+}
+
+Float32 float32_ceil(Context *ctx, Float32 x) {
+  ctx->trapped = 0;
+  return trapped(ctx, OPERATION_CEIL, x, ceil_untrapped(ctx, x));
+}
+
+Float32 float32_trunc(Context *ctx, Float32 x) {
+  ctx->trapped = 0;
+  return trapped(ctx, OPERATION_TRUNC, x, trunc_untrapped(ctx, x));
+}
+
+Float32 float32_sqrt(Context *ctx, Float32 x) {
+  ctx->trapped = 0;
+  return trapped(ctx, OPERATION_SQRT, x, sqrt_untrapped(ctx, x));
 }
 
 Float32 float32_abs(Context *ctx, Float32 x) {
@@ -1,8 +1,49 @@
-#include <stdio.h> // printf
-#include <float.h> // DBL_DIG
-#include <stdlib.h> // atoi
+#include <stdio.h> // fprintf, getline
+#include <stdlib.h> // atoi, free, strtoull
+#include <string.h> // strcmp, strncmp, strcspn, strchr, strlen, strcpy, memcpy
+#include <unistd.h> // sysconf
 
 #include "eval.h"
+#include "sweep.h"
+
+// Records kept by the context for the trace unless -k says otherwise.
+#define RECORDS 4096
+
+typedef enum Profile Profile;
+
+typedef struct Binding Binding;
+typedef struct Options Options;
+
+// How the time spent in each node is rendered, if at all.
+enum Profile {
+  PROFILE_NONE,
+  PROFILE_CHROME, ///< Chrome trace event JSON.
+  PROFILE_FOLDED  ///< Folded stacks for flame graphs.
+};
+
+struct Binding {
+  char name[EXPR_VARIABLE_LENGTH + 1];
+  const char *text; ///< Parsed into [value] once the rounding mode is known.
+  Real32 value;
+};
+
+struct Options {
+  Bool batched;
+  const char *batch_file; ///< FILE given right after -b, if any.
+  Bool compiled;
+  Bool quiet;
+  Bool lanes;
+  Bool stats;
+  Profile profile;
+  Format format;
+  Notation notation;
+  Binding bindings[EXPR_MAX_VARIABLES];
+  Size n_bindings;
+  Bool swept;
+  char sweep_name[EXPR_VARIABLE_LENGTH + 1];
+  char sweep_values[2][64]; ///< START and END of -s, START of -u.
+  Sweep sweep;
+};
 
 static int usage(const char *app) {
   fprintf(stderr, "%s [OPTION]... [EXPRESSION]\n", app);
@@ -14,61 +55,814 @@ static int usage(const char *app) {
   fprintf(stderr, "-t   tininess detection mode\n");
   fprintf(stderr, "      0 - before rounding [default]\n");
   fprintf(stderr, "      1 - after rounding\n");
+  fprintf(stderr, "-x   arithmetic\n");
+  fprintf(stderr, "      soft   - soft-float only [default]\n");
+  fprintf(stderr, "      hybrid - host floating-point unit where it agrees\n");
+  fprintf(stderr, "      check  - hybrid, cross-checked against soft-float at\n");
+  fprintf(stderr, "               random\n");
+  fprintf(stderr, "-E   arithmetic of the error bound\n");
+  fprintf(stderr, "      float   - soft-float in the rounding mode [default]\n");
+  fprintf(stderr, "      integer - integer arithmetic on the bits rounded upward\n");
+  fprintf(stderr, "-c   compile to a program and evaluate without tracing\n");
+  fprintf(stderr, "-q   do not record or print the per-node trace\n");
+  fprintf(stderr, "-k   records kept for the trace [default %d], the trace of\n", RECORDS);
+  fprintf(stderr, "      nodes that make more is incomplete\n");
+  fprintf(stderr, "-o   output format\n");
+  fprintf(stderr, "      text - human readable [default]\n");
+  fprintf(stderr, "      tsv  - tab-separated records\n");
+  fprintf(stderr, "      json - one JSON object per line\n");
+  fprintf(stderr, "-n   notation of values\n");
+  fprintf(stderr, "      shortest - shortest decimal that reads back the same\n");
+  fprintf(stderr, "                 [default]\n");
+  fprintf(stderr, "      hex      - exact hexadecimal floating-point\n");
+  fprintf(stderr, "-p   time every node and write the profile to stderr, not\n");
+  fprintf(stderr, "      with -c, -a or a sweep\n");
+  fprintf(stderr, "      chrome - Chrome trace event JSON\n");
+  fprintf(stderr, "      folded - folded stacks for flame graphs\n");
+  fprintf(stderr, "-a   evaluate under every rounding and tininess mode at once,\n");
+  fprintf(stderr, "      not with -T or -b\n");
+  fprintf(stderr, "-b   batch mode, evaluate one expression per line of FILE\n");
+  fprintf(stderr, "      or stdin when FILE is omitted or '-', not with a sweep\n");
+  fprintf(stderr, "-v   NAME=VALUE, bind a variable\n");
+  fprintf(stderr, "-s   NAME=START:END:COUNT, sweep a variable over COUNT\n");
+  fprintf(stderr, "      evenly spaced values\n");
+  fprintf(stderr, "-u   NAME=START:COUNT[:STEP], sweep a variable over COUNT\n");
+  fprintf(stderr, "      values STEP [default 1] ULPs apart\n");
+  fprintf(stderr, "-f   NAME=FILE, sweep a variable over the native float32\n");
+  fprintf(stderr, "      values of a binary FILE\n");
+  fprintf(stderr, "-e   NAME[=FIRST:LAST], sweep a variable over every float32\n");
+  fprintf(stderr, "      bit pattern [default 0:0xffffffff] on all threads\n");
+  fprintf(stderr, "-j   number of threads for -e [default all cores]\n");
+  fprintf(stderr, "-T   FLAG[,FLAG]..., stop evaluating at the first of these\n");
+  fprintf(stderr, "      exceptions, one of invalid, infinite, overflow,\n");
+  fprintf(stderr, "      underflow and inexact, and log the trap unless sweeping\n");
+  fprintf(stderr, "--stats  print counts of operations, exceptions, rounding\n");
+  fprintf(stderr, "         directions, subnormals and NaNs when done\n");
   return 1;
 }
 
+// Handler installed by -T, [data] is the writer to log the trap to, if any.
+static TrapAction trap_abort(Trap *trap, void *data) {
+  if (data) {
+    writer_trap(data, trap);
+  }
+  return TRAP_ABORT;
+}
+
+// Parse the flags of -T into [traps].
+static Bool parse_traps(Traps *traps, const char *s) {
+  static const char *const FLAGS[] = {
+    "inexact",   // EXCEPTION_INEXACT
+    "underflow", // EXCEPTION_UNDERFLOW
+    "overflow",  // EXCEPTION_OVERFLOW
+    "infinite",  // EXCEPTION_INFINITE
+    "invalid"    // EXCEPTION_INVALID
+  };
+  for (;;) {
+    const Size length = strcspn(s, ",");
+    Size i = 0;
+    while (i < 5 && (strlen(FLAGS[i]) != length || strncmp(s, FLAGS[i], length))) {
+      i++;
+    }
+    if (i == 5) {
+      return false;
+    }
+    traps->handlers[i] = trap_abort;
+    if (!s[length]) {
+      return true;
+    }
+    s += length + 1;
+  }
+}
+
+// Split a "NAME=REST" command line argument.
+static Bool parse_name(const char *arg, char *name, const char **rest) {
+  const char *eq = strchr(arg, '=');
+  if (!eq || eq == arg || (Size)(eq - arg) > EXPR_VARIABLE_LENGTH) {
+    return false;
+  }
+  memcpy(name, arg, eq - arg);
+  name[eq - arg] = '\0';
+  *rest = eq + 1;
+  return true;
+}
+
+// Split [s] into at most [max] ':' separated fields, returns the count.
+static Size parse_fields(const char *s, char fields[][64], Size max) {
+  Size n = 0;
+  for (;;) {
+    const Size length = strcspn(s, ":");
+    if (n == max || length >= sizeof *fields) {
+      return 0;
+    }
+    memcpy(fields[n], s, length);
+    fields[n++][length] = '\0';
+    if (!s[length]) {
+      return n;
+    }
+    s += length + 1;
+  }
+}
+
+static Bool parse_count(const char *s, Uint64 *count) {
+  char *next = NULL;
+  *count = strtoull(s, &next, 0);
+  return next != s && !*next;
+}
+
+static Bool parse_sweep(Options *options, SweepKind kind, const char *arg) {
+  Sweep *sweep = &options->sweep;
+  const char *rest = NULL;
+  if (options->swept) {
+    return false;
+  }
+  if (kind == SWEEP_BITS && !strchr(arg, '=')) {
+    // The range is optional for an exhaustive sweep.
+    if (!*arg || strlen(arg) > EXPR_VARIABLE_LENGTH) {
+      return false;
+    }
+    strcpy(options->sweep_name, arg);
+  } else if (!parse_name(arg, options->sweep_name, &rest)) {
+    return false;
+  }
+  options->swept = true;
+  sweep->kind = kind;
+  sweep->step = 1;
+  sweep->count = 0;
+  sweep->fp = NULL;
+  if (kind == SWEEP_BITS) {
+    Uint64 last = LIT64(0xffffffff);
+    sweep->bits_begin = 0;
+    if (rest) {
+      char fields[2][64];
+      if (parse_fields(rest, fields, 2) != 2
+        || !parse_count(fields[0], &sweep->bits_begin)
+        || !parse_count(fields[1], &last)
+        || last > LIT64(0xffffffff)
+        || last < sweep->bits_begin)
+      {
+        return false;
+      }
+    }
+    sweep->bits_end = last + 1;
+    return true;
+  }
+  if (kind == SWEEP_FILE) {
+    sweep->fp = fopen(rest, "rb");
+    if (!sweep->fp) {
+      fprintf(stderr, "Could not open '%s'\n", rest);
+      return false;
+    }
+    return true;
+  }
+  char fields[3][64];
+  const Size n = parse_fields(rest, fields, 3);
+  if (kind == SWEEP_LINEAR) {
+    if (n != 3 || !parse_count(fields[2], &sweep->count)) {
+      return false;
+    }
+    strcpy(options->sweep_values[0], fields[0]);
+    strcpy(options->sweep_values[1], fields[1]);
+    return true;
+  }
+  if (n < 2 || !parse_count(fields[1], &sweep->count)) {
+    return false;
+  }
+  strcpy(options->sweep_values[0], fields[0]);
+  if (n == 3) {
+    sweep->step = atoi(fields[2]);
+  }
+  return true;
+}
+
+// Parse the values given to -v, -s and -u, which is left until every option
+// is seen as literals are rounded in the modes set by -r and -t.
+static Bool parse_values(Options *options, const Context *c) {
+  for (Size i = 0; i < options->n_bindings; i++) {
+    Binding *binding = &options->bindings[i];
+    if (!expr_parse_value(c, binding->text, &binding->value)) {
+      return false;
+    }
+  }
+  Sweep *sweep = &options->sweep;
+  if (!options->swept || (sweep->kind != SWEEP_LINEAR && sweep->kind != SWEEP_ULP)) {
+    return true;
+  }
+  Real32 start, end;
+  if (!expr_parse_value(c, options->sweep_values[0], &start)) {
+    return false;
+  }
+  sweep->start = start.value;
+  if (sweep->kind == SWEEP_LINEAR) {
+    if (!expr_parse_value(c, options->sweep_values[1], &end)) {
+      return false;
+    }
+    sweep->end = end.value;
+  }
+  return true;
+}
+
+// Apply the command line bindings to the variables of [e], recording the
+// values of every variable in [inputs] for compiled evaluation.
+static void bind(Expression *e, const Options *options, Real32 *inputs) {
+  for (Size i = 0; i < EXPR_MAX_VARIABLES; i++) {
+    inputs[i] = REAL32_ZERO;
+  }
+  for (Size i = 0; i < options->n_bindings; i++) {
+    const Binding *binding = &options->bindings[i];
+    Size index;
+    if (expr_find_variable(e, binding->name, &index)) {
+      expr_bind(e, index, binding->value);
+      inputs[index] = binding->value;
+    }
+  }
+}
+
+// Evaluates [e] either by walking the expression or by compiling it first,
+// in which case [registers] is used as scratch and grown as needed.
+// The trace and profile of interpreted evaluation are rendered to [log] unless
+// the options turn them off, compiled programs are never traced.
+static Bool evaluate(Context *c, Expression *e, const Options *options, const Real32 *inputs, ARRAY(Real32) *registers, Trace *trace, Writer *log, Real32 *result) {
+  if (!options->compiled) {
+    if (options->quiet && options->profile == PROFILE_NONE) {
+      trace = NULL;
+    } else {
+      trace->timed = options->profile != PROFILE_NONE;
+    }
+    *result = expr_eval32(c, e, trace);
+    if (trace) {
+      expr_trace(log, e, trace);
+      array_clear(trace->events);
+    }
+    if (options->profile == PROFILE_CHROME) {
+      expr_profile_chrome(log, e, trace);
+    } else if (options->profile == PROFILE_FOLDED) {
+      expr_profile_folded(log, e, trace);
+    }
+    if (trace) {
+      array_clear(trace->spans);
+    }
+    return true;
+  }
+  Program program;
+  if (!expr_compile(&program, e)) {
+    return false;
+  }
+  const Size size = program_size(&program);
+  if (array_size(*registers) < size) {
+    array_clear(*registers);
+    if (!array_try_grow(*registers, size)) {
+      program_free(&program);
+      return false;
+    }
+    array_meta(*registers)->size = size;
+  }
+  *result = program_eval32(c, &program, inputs, *registers);
+  program_free(&program);
+  return true;
+}
+
+// The "ans", "err" and "exceptions" members of a JSON result.
+static void write_json_result(Writer *out, Real32 result, Exception exceptions) {
+  writer_string(out, "\"ans\":");
+  writer_json_float32(out, result.value);
+  writer_string(out, ",\"err\":");
+  writer_json_float32(out, result.eps);
+  writer_string(out, ",\"exceptions\":\"");
+  writer_exceptions(out, exceptions);
+  writer_char(out, '"');
+}
+
+static void write_batch_error(Writer *out, Size number) {
+  if (out->format == FORMAT_JSON) {
+    writer_printf(out, "{\"line\":%zu,\"error\":true}\n", number);
+  } else {
+    writer_printf(out, "%zu\terror\n", number);
+  }
+}
+
+// Evaluates every newline-delimited expression in [fp] with the same context,
+// writing one record per line. As text or TSV that is "line\tans\terr" on
+// success and "line\terror" when the expression fails to parse.
+static int batch(Context *c, FILE *fp, const Options *options, Writer *out, Writer *log) {
+  ARRAY(Real32) registers = NULL;
+  Trace trace;
+  trace_init(&trace);
+  Real32 inputs[EXPR_MAX_VARIABLES];
+  char *line = NULL;
+  size_t capacity = 0;
+  Size number = 0;
+  int status = 0;
+  while (getline(&line, &capacity, fp) != -1) {
+    number++;
+    line[strcspn(line, "\r\n")] = '\0';
+    if (!*line) {
+      continue;
+    }
+    Expression *e;
+    if (!expr_parse(&e, c, line)) {
+      write_batch_error(out, number);
+      status = 2;
+      continue;
+    }
+    bind(e, options, inputs);
+    context_reset(c);
+    Real32 result;
+    if (!evaluate(c, e, options, inputs, &registers, &trace, log, &result)) {
+      write_batch_error(out, number);
+      expr_free(e);
+      status = 2;
+      continue;
+    }
+    if (out->format == FORMAT_JSON) {
+      writer_printf(out, "{\"line\":%zu,", number);
+      write_json_result(out, result, c->raised);
+      writer_string(out, "}\n");
+    } else {
+      writer_printf(out, "%zu\t", number);
+      writer_float32(out, result.value);
+      writer_char(out, '\t');
+      writer_float32(out, result.eps);
+      writer_char(out, '\n');
+    }
+    expr_free(e);
+  }
+  free(line);
+  trace_free(&trace);
+  array_free(registers);
+  return status;
+}
+
+// Evaluates [e], parsed from [text], under every rounding and tininess mode in
+// a single pass over its compiled program, one context lane per combination.
+// Each lane parses the expression and the values of -v again in its own modes,
+// so it rounds literals as a separate run with -r and -t would.
+static int lanes(Context *c, Expression *e, const char *text, const Options *options, Writer *out) {
+  static const char *ROUNDS[] = {
+    "nearest even", // ROUND_NEAREST_EVEN
+    "to zero",      // ROUND_TO_ZERO
+    "down",         // ROUND_DOWN
+    "up"            // ROUND_UP
+  };
+  static const char *TININESS[] = {
+    "after",  // TININESS_AFTER_ROUNDING
+    "before"  // TININESS_BEFORE_ROUNDING
+  };
+
+  enum { LANES = 8 };
+
+  Context ctx[LANES];
+  for (Size l = 0; l < LANES; l++) {
+    ctx[l].config.round = l / 2;
+    ctx[l].config.tininess = l % 2;
+    ctx[l].config.hardware = c->config.hardware;
+    ctx[l].config.bound = c->config.bound;
+    ctx[l].config.capacity = 0;
+    ctx[l].config.traps = NULL;
+    context_init(&ctx[l]);
+  }
+
+  Program programs[LANES];
+  Real32 inputs[LANES * EXPR_MAX_VARIABLES];
+  Size compiled = 0;
+  for (; compiled < LANES; compiled++) {
+    Expression *lane;
+    if (!expr_parse(&lane, &ctx[compiled], text)) {
+      break;
+    }
+    const Bool ok = expr_compile(&programs[compiled], lane);
+    expr_free(lane);
+    if (!ok) {
+      break;
+    }
+    Real32 *lane_inputs = &inputs[compiled * expr_variables(e)];
+    for (Size i = 0; i < expr_variables(e); i++) {
+      lane_inputs[i] = REAL32_ZERO;
+    }
+    for (Size i = 0; i < options->n_bindings; i++) {
+      const Binding *binding = &options->bindings[i];
+      Size index;
+      if (expr_find_variable(e, binding->name, &index)) {
+        expr_parse_value(&ctx[compiled], binding->text, &lane_inputs[index]);
+      }
+    }
+  }
+  Real32 *registers = compiled == LANES ? malloc(program_size(&programs[0]) * LANES * sizeof *registers) : NULL;
+  if (!registers) {
+    for (Size l = 0; l < LANES; l++) {
+      if (l < compiled) {
+        program_free(&programs[l]);
+      }
+      context_free(&ctx[l]);
+    }
+    return 2;
+  }
+
+  Real32 results[LANES];
+  program_eval32_lanes(ctx, LANES, programs, inputs, registers, results);
+
+  if (out->format == FORMAT_TEXT) {
+    expr_print(out, e);
+    writer_char(out, '\n');
+  }
+  for (Size l = 0; l < LANES; l++) {
+    const char *round = ROUNDS[ctx[l].config.round];
+    const char *tininess = TININESS[ctx[l].config.tininess];
+    switch (out->format) {
+    case FORMAT_TEXT:
+      writer_printf(out, "\t%-12s  %-6s  ans: ", round, tininess);
+      writer_float32(out, results[l].value);
+      writer_string(out, "  err: ");
+      writer_float32(out, results[l].eps);
+      writer_string(out, "  ");
+      break;
+    case FORMAT_TSV:
+      writer_printf(out, "%s\t%s\t", round, tininess);
+      writer_float32(out, results[l].value);
+      writer_char(out, '\t');
+      writer_float32(out, results[l].eps);
+      writer_char(out, '\t');
+      break;
+    case FORMAT_JSON:
+      writer_printf(out, "{\"round\":\"%s\",\"tininess\":\"%s\",", round, tininess);
+      write_json_result(out, results[l], ctx[l].raised);
+      writer_string(out, "}\n");
+      break;
+    }
+    if (out->format != FORMAT_JSON) {
+      writer_exceptions(out, ctx[l].raised);
+      writer_char(out, '\n');
+    }
+    stats_add(&c->stats, &ctx[l].stats);
+    context_free(&ctx[l]);
+  }
+
+  free(registers);
+  for (Size l = 0; l < LANES; l++) {
+    program_free(&programs[l]);
+  }
+  return 0;
+}
+
+// Sweeps the variable named by the options over the range they describe.
+static int sweep(Context *c, Expression *e, Options *options, Writer *out) {
+  Sweep *sweep = &options->sweep;
+  if (!expr_find_variable(e, options->sweep_name, &sweep->input)) {
+    fprintf(stderr, "Unknown variable '%s'\n", options->sweep_name);
+    return 2;
+  }
+
+  Real32 inputs[EXPR_MAX_VARIABLES];
+  bind(e, options, inputs);
+
+  Program program;
+  if (!expr_compile(&program, e)) {
+    return 2;
+  }
+
+  SweepResult result;
+  sweep_result_init(&result);
+  if (!sweep_run(c, &program, inputs, sweep, &result)) {
+    program_free(&program);
+    return 2;
+  }
+  program_free(&program);
+
+  if (out->format == FORMAT_TEXT) {
+    expr_print(out, e);
+    writer_char(out, '\n');
+  }
+  sweep_print(out, options->sweep_name, &result);
+
+  return 0;
+}
+
+static void write_checks(Writer *log, const Context *c) {
+  if (log->format == FORMAT_JSON) {
+    writer_printf(log, "{\"checks\":%zu,\"mismatches\":%zu}\n", c->checks, c->mismatches);
+  } else {
+    writer_printf(log, "hardware check: %zu checked, %zu mismatched\n", c->checks, c->mismatches);
+  }
+}
+
+static void write_result(Writer *out, const Expression *e, Real32 result, Exception exceptions) {
+  switch (out->format) {
+  case FORMAT_TEXT:
+    expr_print(out, e);
+    writer_string(out, "\n\tans: ");
+    writer_float32(out, result.value);
+    writer_string(out, "\n\terr: ");
+    writer_float32(out, result.eps);
+    writer_char(out, '\n');
+    break;
+  case FORMAT_TSV:
+    writer_float32(out, result.value);
+    writer_char(out, '\t');
+    writer_float32(out, result.eps);
+    writer_char(out, '\t');
+    writer_exceptions(out, exceptions);
+    writer_char(out, '\n');
+    break;
+  case FORMAT_JSON:
+    writer_string(out, "{\"expression\":\"");
+    expr_print(out, e);
+    writer_string(out, "\",");
+    write_json_result(out, result, exceptions);
+    writer_string(out, "}\n");
+    break;
+  }
+}
+
+// Everything after option parsing, returns -1 when usage should be printed.
+static int run(Context *c, Options *options, int argc, char **argv, Writer *out, Writer *log) {
+  if (options->batched) {
+    // FILE may also follow the options that came after -b.
+    const char *file = options->batch_file ? options->batch_file : argc ? argv[0] : "-";
+    if (!strcmp(file, "-")) {
+      return batch(c, stdin, options, out, log);
+    }
+    FILE *fp = fopen(file, "r");
+    if (!fp) {
+      fprintf(stderr, "Could not open '%s'\n", file);
+      return 1;
+    }
+    const int status = batch(c, fp, options, out, log);
+    fclose(fp);
+    return status;
+  }
+
+  if (argc == 0) {
+    return -1;
+  }
+
+  Expression *e;
+  if (!expr_parse(&e, c, argv[0])) {
+    return 2;
+  }
+
+  if (options->swept) {
+    const int status = sweep(c, e, options, out);
+    if (options->sweep.fp) {
+      fclose(options->sweep.fp);
+    }
+    expr_free(e);
+    return status;
+  }
+
+  Real32 inputs[EXPR_MAX_VARIABLES];
+  bind(e, options, inputs);
+
+  if (options->lanes) {
+    const int status = lanes(c, e, argv[0], options, out);
+    expr_free(e);
+    return status;
+  }
+
+  ARRAY(Real32) registers = NULL;
+  Real32 result;
+  Trace trace;
+  trace_init(&trace);
+  const Bool ok = evaluate(c, e, options, inputs, &registers, &trace, log, &result);
+  trace_free(&trace);
+  array_free(registers);
+  if (ok) {
+    write_result(out, e, result, c->raised);
+  }
+  expr_free(e);
+
+  return ok ? 0 : 2;
+}
+
 int main(int argc, char **argv) {
+  const char *app = argv[0];
   argc--;
   argv++;
   if (argc == 0) {
-    return usage(argv[-1]);
+    return usage(app);
   }
 
   Context c;
-  c.round = ROUND_NEAREST_EVEN;
-  c.tininess = TININESS_BEFORE_ROUNDING;
-  context_init(&c);
+  c.config.round = ROUND_NEAREST_EVEN;
+  c.config.tininess = TININESS_BEFORE_ROUNDING;
+  c.config.hardware = HARDWARE_NONE;
+  c.config.bound = BOUND_FLOAT;
+  c.config.capacity = RECORDS;
+  c.config.traps = NULL;
+  Traps traps = { { NULL }, NULL };
+
+  Options options = { 0 };
+  const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  options.sweep.threads = cores > 0 ? cores : 1;
 
   // Parse some command line options.
-  if (argv[0][0] == '-') {
-    if (argv[0][1] == 'r') {
+  while (argc && argv[0][0] == '-') {
+    if (!strcmp(argv[0], "--stats")) {
+      argv++; // skip --stats
+      argc--;
+      options.stats = true;
+    } else if (argv[0][1] == 'c') {
+      argv++; // skip -c
+      argc--;
+      options.compiled = true;
+    } else if (argv[0][1] == 'q') {
+      argv++; // skip -q
+      argc--;
+      options.quiet = true;
+    } else if (argv[0][1] == 'k' && argc > 1) {
+      int records = atoi(argv[1]);
+      if (records < 1) {
+        return usage(app);
+      }
+      argv += 2; // skip -k %d
+      argc -= 2;
+      c.config.capacity = records;
+    } else if (argv[0][1] == 'o' && argc > 1) {
+      if (!strcmp(argv[1], "text")) {
+        options.format = FORMAT_TEXT;
+      } else if (!strcmp(argv[1], "tsv")) {
+        options.format = FORMAT_TSV;
+      } else if (!strcmp(argv[1], "json")) {
+        options.format = FORMAT_JSON;
+      } else {
+        return usage(app);
+      }
+      argv += 2; // skip -o %s
+      argc -= 2;
+    } else if (argv[0][1] == 'p' && argc > 1) {
+      if (!strcmp(argv[1], "chrome")) {
+        options.profile = PROFILE_CHROME;
+      } else if (!strcmp(argv[1], "folded")) {
+        options.profile = PROFILE_FOLDED;
+      } else {
+        return usage(app);
+      }
+      argv += 2; // skip -p %s
+      argc -= 2;
+    } else if (argv[0][1] == 'n' && argc > 1) {
+      if (!strcmp(argv[1], "shortest")) {
+        options.notation = NOTATION_SHORTEST;
+      } else if (!strcmp(argv[1], "hex")) {
+        options.notation = NOTATION_HEX;
+      } else {
+        return usage(app);
+      }
+      argv += 2; // skip -n %s
+      argc -= 2;
+    } else if (argv[0][1] == 'x' && argc > 1) {
+      if (!strcmp(argv[1], "soft")) {
+        c.config.hardware = HARDWARE_NONE;
+      } else if (!strcmp(argv[1], "hybrid")) {
+        c.config.hardware = HARDWARE_HYBRID;
+      } else if (!strcmp(argv[1], "check")) {
+        c.config.hardware = HARDWARE_CHECK;
+      } else {
+        return usage(app);
+      }
+      argv += 2; // skip -x %s
+      argc -= 2;
+    } else if (argv[0][1] == 'E' && argc > 1) {
+      if (!strcmp(argv[1], "float")) {
+        c.config.bound = BOUND_FLOAT;
+      } else if (!strcmp(argv[1], "integer")) {
+        c.config.bound = BOUND_INTEGER;
+      } else {
+        return usage(app);
+      }
+      argv += 2; // skip -E %s
+      argc -= 2;
+    } else if (argv[0][1] == 'a') {
+      argv++; // skip -a
+      argc--;
+      options.lanes = true;
+    } else if (argv[0][1] == 'b') {
+      argv++; // skip -b
+      argc--;
+      options.batched = true;
+      if (argc && (argv[0][0] != '-' || !strcmp(argv[0], "-"))) {
+        options.batch_file = argv[0];
+        argv++; // skip FILE
+        argc--;
+      }
+    } else if (argv[0][1] == 'r' && argc > 1) {
       int round = atoi(argv[1]);
       if (round < 0 || round > 3) {
-        return usage(argv[-1]);
+        return usage(app);
       }
       argv += 2; // skip -r %d
       argc -= 2;
-      c.round = round;
-    } else if (argv[0][1] == 't') {
+      c.config.round = round;
+    } else if (argv[0][1] == 't' && argc > 1) {
       int tiny = atoi(argv[1]);
       if (tiny < 0 || tiny > 1) {
-        return usage(argv[-1]);
+        return usage(app);
       }
       argv += 2; // skip -t %d
       argc -= 2;
-      c.tininess = tiny;
+      c.config.tininess = tiny;
+    } else if (argv[0][1] == 'v' && argc > 1) {
+      const char *value = NULL;
+      if (options.n_bindings == EXPR_MAX_VARIABLES) {
+        return usage(app);
+      }
+      Binding *binding = &options.bindings[options.n_bindings++];
+      if (!parse_name(argv[1], binding->name, &value)) {
+        return usage(app);
+      }
+      binding->text = value;
+      argv += 2; // skip -v %s
+      argc -= 2;
+    } else if (argv[0][1] == 's' && argc > 1) {
+      if (!parse_sweep(&options, SWEEP_LINEAR, argv[1])) {
+        return usage(app);
+      }
+      argv += 2; // skip -s %s
+      argc -= 2;
+    } else if (argv[0][1] == 'u' && argc > 1) {
+      if (!parse_sweep(&options, SWEEP_ULP, argv[1])) {
+        return usage(app);
+      }
+      argv += 2; // skip -u %s
+      argc -= 2;
+    } else if (argv[0][1] == 'e' && argc > 1) {
+      if (!parse_sweep(&options, SWEEP_BITS, argv[1])) {
+        return usage(app);
+      }
+      argv += 2; // skip -e %s
+      argc -= 2;
+    } else if (argv[0][1] == 'j' && argc > 1) {
+      int threads = atoi(argv[1]);
+      if (threads < 1) {
+        return usage(app);
+      }
+      argv += 2; // skip -j %d
+      argc -= 2;
+      options.sweep.threads = threads;
+    } else if (argv[0][1] == 'T' && argc > 1) {
+      if (!parse_traps(&traps, argv[1])) {
+        return usage(app);
+      }
+      argv += 2; // skip -T %s
+      argc -= 2;
+      c.config.traps = &traps;
+    } else if (argv[0][1] == 'f' && argc > 1) {
+      if (!parse_sweep(&options, SWEEP_FILE, argv[1])) {
+        return usage(app);
+      }
+      argv += 2; // skip -f %s
+      argc -= 2;
     } else {
-      return usage(argv[-1]);
+      return usage(app);
     }
   }
 
-  if (argc == 0) {
-    return usage(argv[-1]);
+  if (!parse_values(&options, &c)) {
+    return usage(app);
   }
-
-  Expression *e;
-  if (!expr_parse(&e, argv[0])) {
-    return 2;
+  // Only interpreted evaluation of a single mode is timed.
+  if (options.profile != PROFILE_NONE && (options.compiled || options.lanes || options.swept)) {
+    fprintf(stderr, "-p cannot be used with -c, -a or a sweep\n");
+    return usage(app);
   }
+  // Lanes cannot stop on their own and a trap logged by one does not say which.
+  if (options.lanes && c.config.traps) {
+    fprintf(stderr, "-T cannot be used with -a\n");
+    return usage(app);
+  }
+  // Batches write a single record per line.
+  if (options.batched && options.lanes) {
+    fprintf(stderr, "-a cannot be used with -b\n");
+    return usage(app);
+  }
+  if (options.batched && options.swept) {
+    fprintf(stderr, "-b cannot be used with a sweep\n");
+    if (options.sweep.fp) {
+      fclose(options.sweep.fp);
+    }
+    return usage(app);
+  }
+  if (options.quiet) {
+    c.config.capacity = 0;
+  }
+  context_init(&c);
 
-  const Real32 result = expr_eval32(&c, e);
-  expr_print(stdout, e);
-  printf("\n\tans: %.*f\n\terr: %.*f\n",
-    DBL_DIG - 1, float32_cast(result.value),
-    DBL_DIG - 1, float32_cast(result.eps));
-  expr_free(e);
-
+  Writer out;
+  Writer log;
+  writer_init(&out, stdout, options.format);
+  writer_init(&log, stderr, options.format);
+  out.notation = options.notation;
+  log.notation = options.notation;
+  // Sweeps trap on many threads at once and report where they stopped instead.
+  traps.data = options.swept ? NULL : &log;
+  const int status = run(&c, &options, argc, argv, &out, &log);
+  if (c.config.hardware == HARDWARE_CHECK) {
+    write_checks(&log, &c);
+  }
+  if (options.stats) {
+    writer_stats(&log, &c.stats);
+  }
+  // Traces are written before the results they lead up to.
+  writer_flush(&log);
+  writer_flush(&out);
   context_free(&c);
-
-  return 0;
-}
\ No newline at end of file
+  return status == -1 ? usage(app) : status;
+}
@@ -0,0 +1,170 @@
+#include <setjmp.h> // jmp_buf, setjmp
+
+#include "program.h"
+
+void program_init(Program *program) {
+  program->code = NULL;
+  program->values = NULL;
+  program->nodes = NULL;
+  program->inputs = 0;
+}
+
+void program_free(Program *program) {
+  array_free(program->code);
+  array_free(program->values);
+  array_free(program->nodes);
+}
+
+Bool program_emit(Program *program, Uint32 node, Opcode op, Uint32 a, Uint32 b, Uint32 c, Uint32 *r) {
+  const Instruction instruction = { op, a, b, c };
+  *r = array_size(program->code);
+  return array_push(program->code, instruction) && array_push(program->nodes, node);
+}
+
+Bool program_load(Program *program, Uint32 node, Real32 value, Exception raised, Uint32 *r) {
+  const Uint32 index = array_size(program->values);
+  if (!array_push(program->values, value)) {
+    return false;
+  }
+  return program_emit(program, node, OP_LOAD, index, raised, 0, r);
+}
+
+// Literals raise what rounding them raised without trapping, see expr_eval32.
+static inline Real32 load(Context *ctx, const Real32 *values, const Instruction *in) {
+  if (in->b) {
+    context_raise(ctx, in->b);
+  }
+  return values[in->a];
+}
+
+static Real32 run32(Context *ctx, const Program *program, const Real32 *inputs, Real32 *registers) {
+  const Instruction *code = program->code;
+  const Real32 *values = program->values;
+  const Uint32 *nodes = program->nodes;
+  const Size n_code = array_size(code);
+  Real32 *r = registers;
+  for (Size i = 0; i < n_code; i++) {
+    const Instruction *in = &code[i];
+    ctx->node = nodes[i];
+    switch (in->op) {
+    /****/ case OP_LOAD:     r[i] = load(ctx, values, in);
+    break; case OP_VAR:      r[i] = inputs[in->a];
+    break; case OP_FLOOR:    r[i] = real32_floor(ctx, r[in->a]);
+    break; case OP_CEIL:     r[i] = real32_ceil(ctx, r[in->a]);
+    break; case OP_TRUNC:    r[i] = real32_trunc(ctx, r[in->a]);
+    break; case OP_SQRT:     r[i] = real32_sqrt(ctx, r[in->a]);
+    break; case OP_ABS:      r[i] = real32_abs(ctx, r[in->a]);
+    break; case OP_MIN:      r[i] = real32_min(ctx, r[in->a], r[in->b]);
+    break; case OP_MAX:      r[i] = real32_max(ctx, r[in->a], r[in->b]);
+    break; case OP_COPYSIGN: r[i] = real32_copysign(ctx, r[in->a], r[in->b]);
+    break; case OP_EQ:       r[i] = real32_eq(ctx, r[in->a], r[in->b]);
+    break; case OP_LTE:      r[i] = real32_lte(ctx, r[in->a], r[in->b]);
+    break; case OP_LT:       r[i] = real32_lt(ctx, r[in->a], r[in->b]);
+    break; case OP_NE:       r[i] = real32_ne(ctx, r[in->a], r[in->b]);
+    break; case OP_GTE:      r[i] = real32_gte(ctx, r[in->a], r[in->b]);
+    break; case OP_GT:       r[i] = real32_gt(ctx, r[in->a], r[in->b]);
+    break; case OP_ADD:      r[i] = real32_add(ctx, r[in->a], r[in->b]);
+    break; case OP_SUB:      r[i] = real32_sub(ctx, r[in->a], r[in->b]);
+    break; case OP_MUL:      r[i] = real32_mul(ctx, r[in->a], r[in->b]);
+    break; case OP_DIV:      r[i] = real32_div(ctx, r[in->a], r[in->b]);
+    break; case OP_FMA:      r[i] = real32_fma(ctx, r[in->a], r[in->b], r[in->c]);
+    break; case OP_LAST:     r[i] = REAL32_ZERO;
+    break;
+    }
+  }
+  return n_code ? r[n_code - 1] : REAL32_ZERO;
+}
+
+Real32 program_eval32(Context *ctx, const Program *program, const Real32 *inputs, Real32 *registers) {
+  ctx->aborted = false;
+  if (!ctx->trapping) {
+    return run32(ctx, program, inputs, registers);
+  }
+  jmp_buf abort;
+  jmp_buf *const outer = ctx->abort;
+  ctx->abort = &abort;
+  if (setjmp(abort)) {
+    ctx->abort = outer;
+    return REAL32_NAN;
+  }
+  const Real32 result = run32(ctx, program, inputs, registers);
+  ctx->abort = outer;
+  return result;
+}
+
+#define LANES1(name) \
+  for (Size l = 0; l < lanes; l++) { \
+    ctx[l].node = nodes[i]; \
+    r[l] = real32_ ## name(&ctx[l], a[l]); \
+  } \
+  break
+
+#define LANES2(name) \
+  for (Size l = 0; l < lanes; l++) { \
+    ctx[l].node = nodes[i]; \
+    r[l] = real32_ ## name(&ctx[l], a[l], b[l]); \
+  } \
+  break
+
+#define LANES3(name) \
+  for (Size l = 0; l < lanes; l++) { \
+    ctx[l].node = nodes[i]; \
+    r[l] = real32_ ## name(&ctx[l], a[l], b[l], c[l]); \
+  } \
+  break
+
+void program_eval32_lanes(Context *ctx, Size lanes, const Program *programs, const Real32 *inputs, Real32 *registers, Real32 *results) {
+  const Instruction *code = programs->code;
+  const Uint32 *nodes = programs->nodes;
+  const Size n_code = array_size(code);
+  const Size n_inputs = programs->inputs;
+  for (Size l = 0; l < lanes; l++) {
+    ctx[l].aborted = false;
+  }
+  for (Size i = 0; i < n_code; i++) {
+    const Instruction *in = &code[i];
+    Real32 *r = &registers[i * lanes];
+    const Real32 *a = &registers[in->a * lanes];
+    const Real32 *b = &registers[in->b * lanes];
+    const Real32 *c = &registers[in->c * lanes];
+    switch (in->op) {
+    case OP_LOAD:
+      for (Size l = 0; l < lanes; l++) {
+        r[l] = load(&ctx[l], programs[l].values, &programs[l].code[i]);
+      }
+      break;
+    case OP_VAR:
+      for (Size l = 0; l < lanes; l++) {
+        r[l] = inputs[l * n_inputs + in->a];
+      }
+      break;
+    case OP_FLOOR:    LANES1(floor);
+    case OP_CEIL:     LANES1(ceil);
+    case OP_TRUNC:    LANES1(trunc);
+    case OP_SQRT:     LANES1(sqrt);
+    case OP_ABS:      LANES1(abs);
+    case OP_MIN:      LANES2(min);
+    case OP_MAX:      LANES2(max);
+    case OP_COPYSIGN: LANES2(copysign);
+    case OP_EQ:       LANES2(eq);
+    case OP_LTE:      LANES2(lte);
+    case OP_LT:       LANES2(lt);
+    case OP_NE:       LANES2(ne);
+    case OP_GTE:      LANES2(gte);
+    case OP_GT:       LANES2(gt);
+    case OP_ADD:      LANES2(add);
+    case OP_SUB:      LANES2(sub);
+    case OP_MUL:      LANES2(mul);
+    case OP_DIV:      LANES2(div);
+    case OP_FMA:      LANES3(fma);
+    case OP_LAST:
+      for (Size l = 0; l < lanes; l++) {
+        r[l] = REAL32_ZERO;
+      }
+      break;
+    }
+  }
+  for (Size l = 0; l < lanes; l++) {
+    results[l] = n_code ? registers[(n_code - 1) * lanes + l] : REAL32_ZERO;
+  }
+}
@@ -0,0 +1,74 @@
+#ifndef PROGRAM_H
+#define PROGRAM_H
+#include "real32.h"
+
+// Flat, register-based form of an expression.
+//
+// Every instruction writes the register with the same index as itself, so the
+// operands of an instruction always refer to registers written earlier in the
+// program and the result of the program is found in the last register.
+typedef enum Opcode Opcode;
+
+typedef struct Instruction Instruction;
+typedef struct Program Program;
+
+enum Opcode {
+  OP_LOAD, // r = values[a], raising b
+  OP_VAR,  // r = inputs[a]
+  OP_FLOOR, OP_CEIL, OP_TRUNC, OP_SQRT, OP_ABS,
+  OP_MIN, OP_MAX, OP_COPYSIGN,
+  OP_EQ, OP_LTE, OP_LT, OP_NE, OP_GTE, OP_GT,
+  OP_ADD, OP_SUB, OP_MUL, OP_DIV,
+  OP_FMA,  // r = a * b + c
+  OP_LAST  // r = 0
+};
+
+struct Instruction {
+  Uint32 op;
+  Uint32 a;
+  Uint32 b;
+  Uint32 c;
+};
+
+struct Program {
+  ARRAY(Instruction) code;
+  ARRAY(Real32) values; ///< Immediate values referenced by OP_LOAD.
+  ARRAY(Uint32) nodes;  ///< Expression node each instruction was compiled from.
+  Size inputs;          ///< Number of inputs referenced by OP_VAR.
+};
+
+void program_init(Program*);
+void program_free(Program*);
+
+// Append an instruction compiled from expression node [node], writing the
+// register it produces to [r].
+Bool program_emit(Program*, Uint32 node, Opcode op, Uint32 a, Uint32 b, Uint32 c, Uint32 *r);
+
+// Append an OP_LOAD of [value], which raises [raised] like the literal it was
+// rounded from, writing the register it produces to [r].
+Bool program_load(Program*, Uint32 node, Real32 value, Exception raised, Uint32 *r);
+
+// Number of registers needed to run the program.
+static inline Size program_size(const Program *program) {
+  return array_size(program->code);
+}
+
+// Run the program on [inputs] with caller provided scratch [registers] which
+// must hold at least program_size() values. A trap handler that aborts stops
+// the program right away, leaving [aborted] set in the context and returning
+// NaN, and the node of a trap is the expression node of the instruction that
+// raised it, as when evaluating the expression itself.
+Real32 program_eval32(Context*, const Program*, const Real32 *inputs, Real32 *registers);
+
+// Run a program once for each of [lanes] contexts in [ctx], which would
+// typically differ in rounding and tininess mode, sharing a single pass over
+// the instructions. [programs] and [inputs] hold a program and its inputs per
+// lane, the programs compiled from the same expression parsed in the modes of
+// each lane, so they only differ in what OP_LOAD loads and raises.
+// [registers] must hold program_size() * lanes values and the result of each
+// lane is written to [results]. Lanes cannot be stopped
+// on their own, so a lane whose trap handler aborts has [aborted] set and goes
+// on as if the handler had continued.
+void program_eval32_lanes(Context *ctx, Size lanes, const Program *programs, const Real32 *inputs, Real32 *registers, Real32 *results);
+
+#endif // PROGRAM_H
@@ -1,18 +1,142 @@
 #include "real32.h"
 #include "kernel32.h"
 
-// When calculating error we don't want to muddy the value context. Use a copy
-// of it with the same rounding and tininess mode ignoring everything else.
+// When calculating error we don't want to muddy the value context. Use a
+// silent copy of it with the same rounding and tininess mode, made after the
+// value is calculated and handed back with context_unsilence so its hardware
+// checks are counted and sampling does not repeat.
 static inline Context eps_ctx(const Context *ctx) {
   Context c;
-  context_copy(&c, ctx);
+  context_silent(&c, ctx);
   return c;
 }
 
+// Error bounds for BOUND_INTEGER.
+//
+// A bound is a float32 taken as a magnitude, its sign is ignored. Everything
+// is done on the bits with integer arithmetic and rounded upward, so a bound
+// only ever grows from rounding. Infinities and NaNs behave as in IEEE.
+#define BOUND_INFINITY (Float32){LIT32(0x7f800000)}
+
+// x = sig * 2^(exp - 150) with the leading bit of a non-zero sig at bit 23.
+static inline Normal32 bound_unpack(Float32 x) {
+  const Sint16 exp = float32_exp(x);
+  const Uint32 sig = float32_fract(x);
+  if (exp) {
+    return (Normal32){sig | LIT32(0x00800000), exp};
+  }
+  return sig ? float32_normalize_subnormal(sig) : (Normal32){0, 0};
+}
+
+// Round sig * 2^(exp - 150) upward, [sig] must not be zero.
+static inline Float32 bound_pack(Sint32 exp, Uint64 sig) {
+  const Sint32 top = 63 - __builtin_clzll(sig);
+  Sint32 shift = top - 23;
+  exp += shift;
+  if (exp < 1) {
+    // Subnormal, the exponent field is zero and sig stays below bit 23.
+    shift += 1 - exp;
+    exp = 1;
+  }
+  if (shift > 63) {
+    sig = 1;
+  } else if (shift > 0) {
+    const Bool lost = (sig & ((LIT64(1) << shift) - 1)) != 0;
+    sig = (sig >> shift) + lost;
+  } else {
+    sig <<= -shift;
+  }
+  // A carry out of the significand moves into the exponent field by itself.
+  const Uint64 bits = ((Uint64)(exp - 1) << 23) + sig;
+  return bits < LIT32(0x7f800000) ? (Float32){(Uint32)bits} : BOUND_INFINITY;
+}
+
+static inline Float32 bound_nan(Float32 a, Float32 b) {
+  return float32_is_any_nan(a) ? a : b;
+}
+
+// a + b
+static Float32 bound_add(Float32 a, Float32 b) {
+  if (float32_exp(a) == 0xff || float32_exp(b) == 0xff) {
+    const Bool nan = float32_is_any_nan(a) || float32_is_any_nan(b);
+    return nan ? bound_nan(a, b) : BOUND_INFINITY;
+  }
+  Normal32 x = bound_unpack(a);
+  Normal32 y = bound_unpack(b);
+  if (x.exp < y.exp) {
+    const Normal32 t = x;
+    x = y;
+    y = t;
+  }
+  if (!y.sig) {
+    return x.sig ? bound_pack(x.exp, x.sig) : FLOAT32_ZERO;
+  }
+  // Aligned 32 bits up there is room for everything y can lose but a sticky
+  // bit, which is enough to round upward.
+  const Sint32 d = x.exp - y.exp;
+  Uint64 z = (Uint64)y.sig << 32;
+  if (d > 32) {
+    z = (d < 64 ? z >> d : 0) | 1;
+  } else {
+    z >>= d;
+  }
+  return bound_pack(x.exp - 32, ((Uint64)x.sig << 32) + z);
+}
+
+// a * b
+static Float32 bound_mul(Float32 a, Float32 b) {
+  const Normal32 x = bound_unpack(a);
+  const Normal32 y = bound_unpack(b);
+  if (float32_exp(a) == 0xff || float32_exp(b) == 0xff) {
+    const Bool nan = float32_is_any_nan(a) || float32_is_any_nan(b);
+    return nan ? bound_nan(a, b) : x.sig && y.sig ? BOUND_INFINITY : FLOAT32_NAN;
+  }
+  if (!x.sig || !y.sig) {
+    return FLOAT32_ZERO;
+  }
+  return bound_pack(x.exp + y.exp - 150, (Uint64)x.sig * y.sig);
+}
+
+// a / b
+static Float32 bound_div(Float32 a, Float32 b) {
+  const Normal32 x = bound_unpack(a);
+  const Normal32 y = bound_unpack(b);
+  if (float32_exp(a) == 0xff || float32_exp(b) == 0xff) {
+    if (float32_is_any_nan(a) || float32_is_any_nan(b)) {
+      return bound_nan(a, b);
+    }
+    return float32_exp(b) != 0xff ? BOUND_INFINITY : float32_exp(a) != 0xff ? FLOAT32_ZERO : FLOAT32_NAN;
+  }
+  if (!y.sig) {
+    return x.sig ? BOUND_INFINITY : FLOAT32_NAN;
+  }
+  if (!x.sig) {
+    return FLOAT32_ZERO;
+  }
+  // Over 39 bits of quotient, the remainder is a sticky bit below them.
+  const Uint64 n = (Uint64)x.sig << 40;
+  const Uint64 q = n / y.sig;
+  return bound_pack(x.exp - y.exp + 110, q | (q * y.sig != n));
+}
+
+// EPSILON * abs(value)
+static inline Float32 bound_ulp(Float32 value) {
+  return bound_mul(FLOAT32_EPSILON, value);
+}
+
+// a > b for bounds that are not NaN.
+static inline Bool bound_gt(Float32 a, Float32 b) {
+  return (a.bits & LIT32(0x7fffffff)) > (b.bits & LIT32(0x7fffffff));
+}
+
 Real32 real32_add(Context *ctx, Real32 a, Real32 b) {
-  Context ec = eps_ctx(ctx);
+  if (ctx->config.bound == BOUND_INTEGER) {
+    const Float32 value = float32_add(ctx, a.value, b.value);
+    return (Real32){value, bound_add(bound_add(a.eps, b.eps), bound_ulp(value))};
+  }
   Real32 r;
   r.value = float32_add(ctx, a.value, b.value);
+  Context ec = eps_ctx(ctx);
   r.eps = 
     float32_add(
       &ec,
@@ -20,13 +144,18 @@ Real32 real32_add(Context *ctx, Real32 a, Real32 b) {
       float32_add(&ec, a.eps, b.eps),
       // EPSILON * abs(value)
       float32_mul(&ec, FLOAT32_EPSILON, float32_abs(&ec, r.value)));
+  context_unsilence(ctx, &ec);
   return r;
 }
 
 Real32 real32_sub(Context *ctx, Real32 a, Real32 b) {
-  Context ec = eps_ctx(ctx);
+  if (ctx->config.bound == BOUND_INTEGER) {
+    const Float32 value = float32_sub(ctx, a.value, b.value);
+    return (Real32){value, bound_add(bound_add(a.eps, b.eps), bound_ulp(value))};
+  }
   Real32 r;
   r.value = float32_sub(ctx, a.value, b.value);
+  Context ec = eps_ctx(ctx);
   r.eps = 
     float32_add(
       &ec,
@@ -34,13 +163,19 @@ Real32 real32_sub(Context *ctx, Real32 a, Real32 b) {
       float32_add(&ec, a.eps, b.eps),
       // EPSILON * abs(value)
       float32_mul(&ec, FLOAT32_EPSILON, float32_abs(&ec, r.value)));
+  context_unsilence(ctx, &ec);
   return r;
 }
 
 Real32 real32_mul(Context *ctx, Real32 a, Real32 b) {
-  Context ec = eps_ctx(ctx);
+  if (ctx->config.bound == BOUND_INTEGER) {
+    const Float32 value = float32_mul(ctx, a.value, b.value);
+    const Float32 e = bound_add(bound_mul(a.eps, b.value), bound_mul(b.eps, a.value));
+    return (Real32){value, bound_add(bound_add(e, bound_mul(a.eps, b.eps)), bound_ulp(value))};
+  }
   Real32 r;
   r.value = float32_mul(ctx, a.value, b.value);
+  Context ec = eps_ctx(ctx);
   r.eps = float32_add(
     &ec,
     float32_add(
@@ -55,16 +190,73 @@ Real32 real32_mul(Context *ctx, Real32 a, Real32 b) {
       float32_mul(&ec, a.eps, b.eps)),
     // EPSILON * abs(value)
     float32_mul(&ec, FLOAT32_EPSILON, float32_abs(&ec, r.value)));
+  context_unsilence(ctx, &ec);
+  return r;
+}
+
+// err(a*b+c) = err(a) * abs(b) + err(b) * abs(a) + err(a) * err(b) + err(c)
+//            + EPSILON * abs(value)
+//
+// The sum of products is itself accumulated with fused multiply-adds.
+Real32 real32_fma(Context *ctx, Real32 a, Real32 b, Real32 c) {
+  if (ctx->config.bound == BOUND_INTEGER) {
+    const Float32 value = float32_fma(ctx, a.value, b.value, c.value);
+    const Float32 e = bound_add(bound_mul(a.eps, b.value), bound_mul(b.eps, a.value));
+    const Float32 f = bound_add(bound_mul(a.eps, b.eps), bound_add(bound_ulp(value), c.eps));
+    return (Real32){value, bound_add(e, f)};
+  }
+  Real32 r;
+  r.value = float32_fma(ctx, a.value, b.value, c.value);
+  Context ec = eps_ctx(ctx);
+  r.eps =
+    float32_fma(
+      &ec,
+      a.eps,
+      float32_abs(&ec, b.value),
+      float32_fma(
+        &ec,
+        b.eps,
+        float32_abs(&ec, a.value),
+        float32_fma(
+          &ec,
+          a.eps,
+          b.eps,
+          float32_fma(
+            &ec,
+            FLOAT32_EPSILON,
+            float32_abs(&ec, r.value),
+            c.eps))));
+  context_unsilence(ctx, &ec);
+  return r;
+}
+
+Real32 real32_rounded(Context *ctx, Float32 value) {
+  if (ctx->config.bound == BOUND_INTEGER) {
+    return (Real32){value, bound_ulp(value)};
+  }
+  Context ec = eps_ctx(ctx);
+  // EPSILON * abs(value)
+  const Real32 r = {value, float32_mul(&ec, FLOAT32_EPSILON, float32_abs(&ec, value))};
+  context_unsilence(ctx, &ec);
   return r;
 }
 
 // Calculating division error is non-trivial when the divisor is inaccurate,
 // use the following to recover inaccuracies for inaccurate divisor
 // r^2(-x) - r*x + 0 = 0
+//
+// Integer bounds only take the common case of an accurate divisor.
+static const Float32 INACCURATE = {LIT32(0x3c23d70a)}; // 0.01f
+
 Real32 real32_div(Context *ctx, Real32 a, Real32 b) {
-  Context ec = eps_ctx(ctx);
+  if (ctx->config.bound == BOUND_INTEGER && !bound_gt(b.eps, bound_mul(INACCURATE, b.value))) {
+    const Float32 value = float32_div(ctx, a.value, b.value);
+    const Float32 e = bound_div(bound_add(a.eps, bound_mul(value, b.eps)), b.value);
+    return (Real32){value, bound_add(e, bound_ulp(value))};
+  }
   Real32 r;
   r.value = float32_div(ctx, a.value, b.value);
+  Context ec = eps_ctx(ctx);
   
   const Float32 abs_b = float32_abs(&ec, b.value);
   const Float32 abs_r = float32_abs(&ec, r.value);
@@ -79,8 +271,7 @@ Real32 real32_div(Context *ctx, Real32 a, Real32 b) {
       abs_b);
   
   // Use more accurate for inaccurate divisors.
-  static const Float32 EPS = {LIT32(0x3c23d70a)}; // 0.01f
-  if (float32_gt(&ec, b.eps, float32_mul(&ec, EPS, abs_b))) {
+  if (float32_gt(&ec, b.eps, float32_mul(&ec, INACCURATE, abs_b))) {
     const Float32 r = float32_div(&ec, b.eps, b.value);
     // e = e * (1 + (1 + r) * r)
     e = float32_mul(
@@ -108,11 +299,20 @@ Real32 real32_div(Context *ctx, Real32 a, Real32 b) {
       e,
       // EPSILON * abs(value)
       float32_mul(&ec, FLOAT32_EPSILON, float32_abs(&ec, r.value)));
-  
+  context_unsilence(ctx, &ec);
   return r;
 }
 
+// Integer bounds only take the common case of an input well away from zero.
 Real32 real32_sqrt(Context *ctx, Real32 x) {
+  static const Float32 TEN = {LIT32(0x41200000)}; // 10.0f
+  if (ctx->config.bound == BOUND_INTEGER && !float32_sign(x.value) && !float32_is_any_nan(x.value) && bound_gt(x.value, bound_mul(TEN, x.eps))) {
+    const Float32 r = float32_sqrt(ctx, x.value);
+    // 0.5 * (err(x) / r) + EPSILON * abs(r)
+    const Float32 d = bound_mul(FLOAT32_HALF, bound_div(x.eps, r));
+    return (Real32){r, bound_add(d, bound_ulp(r))};
+  }
+  const Float32 value = float32_sqrt(ctx, x.value);
   Context ec = eps_ctx(ctx);
 
   // Calculate error.
@@ -147,7 +347,8 @@ Real32 real32_sqrt(Context *ctx, Real32 x) {
     }
   }
 
-  return (Real32){float32_sqrt(ctx, x.value), d};
+  context_unsilence(ctx, &ec);
+  return (Real32){value, d};
 }
 
 // Operations that cannot generate error.
@@ -13,6 +13,12 @@
 //
 // The error result of an elementary floating-point operation does not exceed
 // and is close to abs(result) * EPSILON.
+//
+// The bound is computed by soft-float in the modes of the context, or with
+// BOUND_INTEGER by a few integer operations on its bits that round upward, so
+// it cannot come out too small from rounding of its own. Divisors with over
+// 1% error and square roots of values within ten errors of zero take the
+// soft-float path either way.
 typedef struct Real32 Real32;
 
 struct Real32 {
@@ -32,6 +38,10 @@ Real32 real32_add(Context *ctx, Real32 a, Real32 b);
 Real32 real32_sub(Context *ctx, Real32 a, Real32 b);
 Real32 real32_mul(Context *ctx, Real32 a, Real32 b);
 Real32 real32_div(Context *ctx, Real32 a, Real32 b);
+Real32 real32_fma(Context *ctx, Real32 a, Real32 b, Real32 c);
+
+// The error of rounding something exact, like a decimal literal, to [value].
+Real32 real32_rounded(Context *ctx, Float32 value);
 
 #define REAL32_WRAP1_NO_ERROR(name) \
   Real32 real32_ ## name(Context *ctx, Real32 a)
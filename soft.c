@@ -1,36 +1,154 @@
+#include <setjmp.h> // longjmp
+#include <stdlib.h> // malloc, free
+#include <string.h> // memset
+
 #include "float32.h"
 #include "float64.h"
+#include "hybrid.h"
 
 void context_init(Context* context) {
-  context->exceptions = NULL;
-  context->operations = NULL;
   context->roundings = 0;
+  context->raised = 0;
+  context->n_exceptions = 0;
+  context->n_operations = 0;
+  context->records = NULL;
+  if (context->config.capacity) {
+    Size capacity = 1;
+    while (capacity < context->config.capacity) {
+      capacity <<= 1;
+    }
+    context->records = malloc(capacity * sizeof *context->records);
+    context->config.capacity = context->records ? capacity : 0;
+  }
+  if (context->config.hardware == HARDWARE_NONE) {
+    context->float32 = float32_ops(context->config.round, context->config.tininess);
+    context->float64 = float64_ops(context->config.round, context->config.tininess);
+  } else {
+    const Bool check = context->config.hardware == HARDWARE_CHECK;
+    context->float32 = float32_hybrid_ops(context->config.round, context->config.tininess, check);
+    context->float64 = float64_hybrid_ops(context->config.round, context->config.tininess, check);
+  }
+  context->seed = 0x9e3779b9;
+  context->checks = 0;
+  context->mismatches = 0;
+  memset(&context->stats, 0, sizeof context->stats);
+  context->trapping = 0;
+  for (Size i = 0; context->config.traps && i < 5; i++) {
+    context->trapping |= context->config.traps->handlers[i] ? 1 << i : 0;
+  }
+  context->trapped = 0;
+  context->node = 0;
+  context->abort = NULL;
+  context->aborted = false;
 }
 
 void context_free(Context* context) {
-  array_free(context->exceptions);
-  array_free(context->operations);
+  free(context->records);
+  context->records = NULL;
+}
+
+void context_reset(Context* context) {
+  context->roundings = 0;
+  context->raised = 0;
+  context->n_exceptions = 0;
+  context->n_operations = 0;
+  context->trapped = 0;
+  context->aborted = false;
 }
 
 void context_copy(Context* dst, const Context *src) {
+  dst->config = src->config;
+  dst->config.capacity = 0;
+  dst->config.traps = NULL;
   context_init(dst);
-  dst->round = src->round;
-  dst->tininess = src->tininess;
 }
 
-bool context_raise(Context *context, Exception exception) {
-  return array_push(context->exceptions, exception);
+void context_fork(Context *dst, const Context *src, Uint64 stream) {
+  dst->config = src->config;
+  context_init(dst);
+  // A splitmix64 step, xorshift needs a seed other than zero.
+  Uint64 z = src->seed + (stream + 1) * LIT64(0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * LIT64(0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * LIT64(0x94d049bb133111eb);
+  z ^= z >> 31;
+  dst->seed = (Uint32)z ? (Uint32)z : 0x9e3779b9;
 }
 
-static Float32 canonical_nan_to_float32(CanonicalNaN nan) {
-  return (Float32){(((Uint32)nan.sign) << 31) | LIT32(0x7FC00000) | (nan.hi >> 41)};
+void context_merge(Context *dst, const Context *src) {
+  if (dst->records && src->records) {
+    const Size events = context_events(dst);
+    const Size n_events = context_events(src);
+    const Size first = n_events > src->config.capacity ? n_events - src->config.capacity : 0;
+    for (Size i = first; i < n_events; i++) {
+      const Record *record = context_record(src, i);
+      if (record) {
+        const Size base = record->kind == EVENT_EXCEPTION ? dst->n_exceptions : dst->n_operations;
+        const Size event = events + i;
+        dst->records[event & (dst->config.capacity - 1)] = (Record){ event, base + record->index, record->kind, record->value };
+      }
+    }
+  }
+  dst->roundings += src->roundings;
+  dst->raised |= src->raised;
+  dst->n_exceptions += src->n_exceptions;
+  dst->n_operations += src->n_operations;
+  dst->checks += src->checks;
+  dst->mismatches += src->mismatches;
+  dst->aborted |= src->aborted;
+  stats_add(&dst->stats, &src->stats);
 }
 
-static Float64 canonical_nan_to_float64(CanonicalNaN nan) {
-  return (Float64){(((Uint64)nan.sign) << 63) | LIT64(0x7FF8000000000000) | (nan.hi >> 12)};
+Float32 context_trap(Context *ctx, Operation operation, Float32 a, Float32 b, Float32 c, Float32 result) {
+  const Exception trapped = ctx->trapped;
+  ctx->trapped = 0;
+  Trap trap = { 0, operation, ctx->node, { a, b, c }, result };
+  for (Size i = 0; i < 5; i++) {
+    if (!(trapped & (1 << i))) {
+      continue;
+    }
+    trap.exception = 1 << i;
+    switch (ctx->config.traps->handlers[i](&trap, ctx->config.traps->data)) {
+    case TRAP_CONTINUE:
+      trap.result = result;
+      break;
+    case TRAP_SUBSTITUTE:
+      result = trap.result;
+      break;
+    case TRAP_ABORT:
+      ctx->aborted = true;
+      if (ctx->abort) {
+        longjmp(*ctx->abort, 1);
+      }
+      return result;
+    }
+  }
+  return result;
+}
+
+void stats_add(Stats *dst, const Stats *src) {
+  for (Size i = 0; i < STATS_OPERATIONS; i++) {
+    dst->operations[i] += src->operations[i];
+  }
+  for (Size i = 0; i < 32; i++) {
+    dst->raises[i] += src->raises[i];
+  }
+  dst->rounded[0] += src->rounded[0];
+  dst->rounded[1] += src->rounded[1];
+  dst->subnormal_inputs += src->subnormal_inputs;
+  dst->subnormal_outputs += src->subnormal_outputs;
+  dst->nans += src->nans;
+}
+
+Size stats_exception(const Stats *stats, Exception exception) {
+  Size count = 0;
+  for (Size i = 0; i < 32; i++) {
+    count += i & exception ? stats->raises[i] : 0;
+  }
+  return count;
 }
 
 Float32 float64_to_float32(Context *ctx, Float64 a) {
+  STATS(ctx, operations[STATS_CONVERT], 1);
   Uint64 a_sig = float64_fract(a);
   Sint16 a_exp = float64_exp(a);
   Flag a_sign = float64_sign(a);
@@ -49,6 +167,7 @@ Float32 float64_to_float32(Context *ctx, Float64 a) {
 }
 
 Float64 float32_to_float64(Context *ctx, Float32 a) {
+  STATS(ctx, operations[STATS_CONVERT], 1);
   Uint32 a_sig = float32_fract(a);
   Sint16 a_exp = float32_exp(a);
   Flag a_sign = float32_sign(a);
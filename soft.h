@@ -1,5 +1,8 @@
 #ifndef SOFT_H
 #define SOFT_H
+#include <setjmp.h> // jmp_buf
+#include <string.h> // memset
+
 #include "array.h"
 
 typedef Sint8 Flag;
@@ -8,8 +11,18 @@ typedef enum Round Round;
 typedef enum Exception Exception;
 typedef enum Tininess Tininess;
 typedef enum Operation Operation;
+typedef enum Hardware Hardware;
+typedef enum Bound Bound;
+typedef enum TrapAction TrapAction;
 
+typedef struct Config Config;
 typedef struct Context Context;
+typedef struct Record Record;
+typedef struct Stats Stats;
+typedef struct Trap Trap;
+typedef struct Traps Traps;
+typedef struct Float32Ops Float32Ops;
+typedef struct Float64Ops Float64Ops;
 
 typedef struct Float32 Float32;
 typedef struct Float64 Float64;
@@ -67,21 +80,269 @@ enum Operation {
   OPERATION_ADD,
   OPERATION_SUB,
   OPERATION_MUL,
-  OPERATION_DIV
+  OPERATION_DIV,
+  OPERATION_FMA,
+  // Kernels built from the operations above, which are what is recorded for
+  // them. They only trap, once and as a whole.
+  OPERATION_FLOOR,
+  OPERATION_CEIL,
+  OPERATION_TRUNC,
+  OPERATION_SQRT
 };
 
-struct Context {
+// Kinds of records kept by a context.
+enum {
+  EVENT_EXCEPTION,
+  EVENT_OPERATION
+};
+
+// An exception raised or an operation carried out, [index] is its position
+// among the exceptions or operations of the context since it was reset and
+// [event] among both.
+struct Record {
+  Uint32 event;
+  Uint32 index;
+  Uint8 kind;
+  Uint8 value; ///< Exception flags or Operation.
+};
+
+// Operations counted by Stats.
+enum {
+  STATS_ADD,
+  STATS_SUB,
+  STATS_MUL,
+  STATS_DIV,
+  STATS_FMA,
+  STATS_SQRT,
+  STATS_COMPARE,
+  STATS_CONVERT,
+  STATS_OPERATIONS
+};
+
+// Counts of what float32 and float64 arithmetic did in a context, kept since
+// context_init. Batched forms only count their operations.
+struct Stats {
+  Size operations[STATS_OPERATIONS];
+  Size raises[32];          ///< Per set of flags raised, see stats_exception.
+  Size rounded[2];         ///< Inexact results below and above the exact one.
+  Size subnormal_inputs;   ///< Subnormal operands of arithmetic.
+  Size subnormal_outputs;  ///< Subnormal results of arithmetic.
+  Size nans;               ///< Results that propagate a NaN operand.
+};
+
+// Counting is a plain increment of a member of Stats, which building with
+// STATS_DISABLED compiles out along with the evaluation of [n].
+#if defined(STATS_DISABLED)
+#define STATS_ENABLED 0
+#define STATS(ctx, counter, n) ((void)sizeof((ctx)->stats.counter += (n)))
+#else
+#define STATS_ENABLED 1
+#define STATS(ctx, counter, n) ((void)((ctx)->stats.counter += (n)))
+#endif
+
+void stats_add(Stats *dst, const Stats *src);
+
+// Times [exception], a single flag, was raised.
+Size stats_exception(const Stats*, Exception);
+
+// Where arithmetic is carried out, see hybrid.h.
+enum Hardware {
+  HARDWARE_NONE,   ///< Soft-float only.
+  HARDWARE_HYBRID, ///< Host floating-point unit where it agrees with soft-float.
+  HARDWARE_CHECK   ///< Same as HARDWARE_HYBRID, cross-checked at random.
+};
+
+// How Real32 bounds the error of a result, see real32.h.
+enum Bound {
+  BOUND_FLOAT,  ///< Soft-float in the modes of the context.
+  BOUND_INTEGER ///< Integer arithmetic on the bits, rounded upward.
+};
+
+// Arithmetic specialized for one rounding and tininess mode, so the per
+// operation path never branches on either.
+struct Float32Ops {
+  Float32 (*round_and_pack)(Context*, Flag sign, Sint32 exp, Uint32 sig);
+  Float32 (*add)(Context*, Float32, Float32);
+  Float32 (*sub)(Context*, Float32, Float32);
+  Float32 (*mul)(Context*, Float32, Float32);
+  Float32 (*div)(Context*, Float32, Float32);
+  Float32 (*fma)(Context*, Float32, Float32, Float32);
+};
+
+struct Float64Ops {
+  Float64 (*round_and_pack)(Context*, Flag sign, Sint32 exp, Uint64 sig);
+  Float64 (*add)(Context*, Float64, Float64);
+  Float64 (*sub)(Context*, Float64, Float64);
+  Float64 (*mul)(Context*, Float64, Float64);
+  Float64 (*div)(Context*, Float64, Float64);
+  Float64 (*fma)(Context*, Float64, Float64, Float64);
+};
+
+// What a trap handler wants done with the operation that trapped.
+enum TrapAction {
+  TRAP_CONTINUE,   ///< Keep the result and go on.
+  TRAP_SUBSTITUTE, ///< Use [result] of the Trap instead and go on.
+  TRAP_ABORT       ///< Stop evaluating, see context_trap.
+};
+
+// An exception trapped by float32 arithmetic. [node] is the expression node
+// being evaluated at the time.
+struct Trap {
+  Exception exception; ///< The single flag trapped.
+  Operation operation;
+  Uint32 node;
+  Float32 operands[3]; ///< As many as [operation] takes.
+  Float32 result;
+};
+
+typedef TrapAction (*TrapHandler)(Trap*, void *data);
+
+// Handlers per exception flag, lowest first, NULL for those not trapped.
+struct Traps {
+  TrapHandler handlers[5];
+  void *data;
+};
+
+// How a context carries out arithmetic. It is set before context_init and
+// never changes after that, so forks of a context on other threads share it.
+struct Config {
   Round round;
-  Size roundings;
-  ARRAY(Exception) exceptions; ///< Array of flags of triggered exceptions.
-  ARRAY(Operation) operations; ///< Array of all operations carried out 
   Tininess tininess;
+  Hardware hardware;
+  Bound bound;
+  Size capacity;              ///< Records kept, 0 for none.
+  const Traps *traps;         ///< NULL when nothing is trapped.
 };
 
+// Everything but the configuration is accumulated by the one thread using the
+// context, and combined across threads with context_fork and context_merge.
+struct Context {
+  Config config;
+  const Float32Ops *float32;  ///< Picked for the configuration by context_init.
+  const Float64Ops *float64;  ///< Picked for the configuration by context_init.
+  Size roundings;
+  Exception raised;           ///< Sticky flags of every exception raised.
+  Size n_exceptions;          ///< Exceptions raised.
+  Size n_operations;          ///< Operations carried out.
+  Record *records;            ///< Ring of the last [capacity] records.
+  Uint32 seed;                ///< State of the sampling done by HARDWARE_CHECK.
+  Size checks;                ///< Results checked by HARDWARE_CHECK.
+  Size mismatches;            ///< Results HARDWARE_CHECK found to disagree.
+  Stats stats;
+  Exception trapping;         ///< Flags with a handler, set by context_init.
+  Exception trapped;          ///< Flags raised by the operation in progress.
+  Uint32 node;                ///< Node being evaluated, see Trap.
+  jmp_buf *abort;             ///< Where TRAP_ABORT unwinds to, if anywhere.
+  Bool aborted;               ///< Set by TRAP_ABORT.
+};
+
+const Float32Ops *float32_ops(Round, Tininess);
+const Float64Ops *float64_ops(Round, Tininess);
+
+// The configuration must be set before calling this, and the context
+// initialized again if it changes. The capacity is rounded up to a power of two
+// and the ring is the only thing allocated, once and here, so recording never
+// allocates.
 void context_init(Context* context);
 void context_free(Context* context);
+
+// Clear what was raised, counted and recorded, but not the checks and stats.
+void context_reset(Context* context);
+
+// Initialize [dst] with the configuration of [src] but no records or traps.
 void context_copy(Context* dst, const Context *src);
-bool context_raise(Context *context, Exception exception);
+
+// Initialize [dst] with the configuration of [src] and nothing accumulated, for
+// another thread. [stream] picks the results HARDWARE_CHECK samples, so forks
+// given the same stream for the same work check the same results whichever
+// thread runs them.
+void context_fork(Context *dst, const Context *src, Uint64 stream);
+
+// Add what [src] accumulated to [dst]: counts, checks and stats are summed and
+// sticky flags combined, which gives the same in any order, and the records
+// [src] kept follow those of [dst] as if [dst] had made them, so merging forks
+// in a fixed order gives the same records however the threads were scheduled.
+// The sampling state of [dst] is left alone.
+void context_merge(Context *dst, const Context *src);
+
+// A context with the modes, hardware and arithmetic of [src] that keeps no
+// records and takes no traps, for arithmetic nobody inspects the exceptions
+// of. It allocates nothing and needs no context_free, everything it counts
+// starts from zero. Its sampling continues that of [src], context_unsilence
+// hands the sampling and what HARDWARE_CHECK found back.
+static inline void context_silent(Context *dst, const Context *src) {
+  dst->config = src->config;
+  dst->config.capacity = 0;
+  dst->config.traps = NULL;
+  dst->float32 = src->float32;
+  dst->float64 = src->float64;
+  dst->roundings = 0;
+  dst->raised = 0;
+  dst->n_exceptions = 0;
+  dst->n_operations = 0;
+  dst->records = NULL;
+  dst->seed = src->seed;
+  dst->checks = 0;
+  dst->mismatches = 0;
+  dst->trapping = 0;
+  dst->trapped = 0;
+  memset(&dst->stats, 0, sizeof dst->stats);
+  dst->node = 0;
+  dst->abort = NULL;
+  dst->aborted = false;
+}
+
+// Take the checks and mismatches of silent context [src] into [dst], the
+// context it was made from, and carry on sampling where [src] stopped.
+static inline void context_unsilence(Context *dst, const Context *src) {
+  dst->seed = src->seed;
+  dst->checks += src->checks;
+  dst->mismatches += src->mismatches;
+}
+
+// Number of records made since the reset, kept or not.
+static inline Size context_events(const Context *context) {
+  return context->n_exceptions + context->n_operations;
+}
+
+// The record numbered [event] since the reset, NULL once the ring has wrapped
+// over it, when it was only counted or when no records are kept.
+static inline const Record *context_record(const Context *context, Size event) {
+  if (!context->records || event >= context_events(context) || context_events(context) - event > context->config.capacity) {
+    return NULL;
+  }
+  const Record *record = &context->records[event & (context->config.capacity - 1)];
+  return record->event == (Uint32)event ? record : NULL;
+}
+
+static inline void context_push(Context *context, Uint8 kind, Uint8 value, Size index) {
+  if (context->records) {
+    const Size event = context_events(context);
+    context->records[event & (context->config.capacity - 1)] = (Record){ event, index, kind, value };
+  }
+}
+
+static inline void context_raise(Context *context, Exception exception) {
+  STATS(context, raises[exception & 31], 1);
+  context_push(context, EVENT_EXCEPTION, exception, context->n_exceptions);
+  context->raised |= exception;
+  context->trapped |= exception & context->trapping;
+  context->n_exceptions++;
+}
+
+// Calls the handlers of the flags [ctx] trapped in an operation that gave
+// [result], lowest flag first, and returns the result they settled on.
+// TRAP_ABORT sets [aborted] and unwinds to [abort] with longjmp unless that
+// is NULL, in which case it returns like TRAP_CONTINUE and it is up to the
+// caller to stop.
+Float32 context_trap(Context *ctx, Operation, Float32 a, Float32 b, Float32 c, Float32 result);
+
+// Records an operation starting now. Only what is raised after [trapped] is
+// cleared can trap, which the trapping forms of the operations do first.
+static inline void context_operation(Context *context, Operation operation) {
+  context_push(context, EVENT_OPERATION, operation, context->n_operations);
+  context->n_operations++;
+}
 
 // Special right shifts where the least significant bit of result is set when
 // any non-zero bits are shifted off.
@@ -103,6 +364,54 @@ static inline Uint64 rshr64(Uint64 a, Sint16 count) {
   return a != 0 ? 1 : 0;
 }
 
+// Conversion of sign * sig * 2^-count to an integer format whose magnitude is
+// at most [max_positive] for positive and [max_negative] for negative results,
+// rounded in [round] mode. A negative [count] means the value is too large for
+// any of the formats. The result is two's complement and truncated by the
+// caller, exceptions are reported in [raised] rather than a context, and
+// anything out of range is invalid and gives [invalid].
+static inline Uint64 integer_round_and_pack(Round round, Flag sign, Uint64 sig, Sint32 count, Uint64 max_positive, Uint64 max_negative, Uint64 invalid, Uint8 *raised) {
+  if (count < 0) {
+    *raised = EXCEPTION_INVALID;
+    return invalid;
+  }
+  Uint64 integer = 0;
+  Uint64 rest = sig;
+  if (count == 0) {
+    integer = sig;
+    rest = 0;
+  } else if (count < 64) {
+    integer = sig >> count;
+    rest = sig << (64 - count);
+  } else if (count > 64) {
+    // Less than half, as no significand reaches 2^63 here.
+    rest = sig != 0;
+  }
+  const Flag half = rest >> 63;
+  const Flag sticky = (rest << 1) != 0;
+  Flag up = 0;
+  switch (round) {
+  case ROUND_NEAREST_EVEN:
+    up = half & (sticky | (integer & 1));
+    break;
+  case ROUND_TO_ZERO:
+    break;
+  case ROUND_DOWN:
+    up = sign & (half | sticky);
+    break;
+  case ROUND_UP:
+    up = (sign ^ 1) & (half | sticky);
+    break;
+  }
+  integer += up;
+  if (integer > (sign ? max_negative : max_positive)) {
+    *raised = EXCEPTION_INVALID;
+    return invalid;
+  }
+  *raised = (half | sticky) ? EXCEPTION_INEXACT : 0;
+  return sign ? -integer : integer;
+}
+
 Float32 float64_to_float32(Context*, Float64);
 Float64 float32_to_float64(Context*, Float32);
 
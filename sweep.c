@@ -0,0 +1,486 @@
+#include <stdlib.h> // malloc, free
+#include <pthread.h> // pthread_create, pthread_join
+
+#include "sweep.h"
+
+typedef struct SweepShared SweepShared;
+typedef struct SweepChunk SweepChunk;
+typedef struct SweepThread SweepThread;
+
+// Bit patterns are handed to threads in chunks of this many, in increasing
+// order, so every thread sees its inputs in increasing bit pattern order.
+#define SWEEP_CHUNK LIT64(0x10000)
+
+struct SweepShared {
+  const Context *ctx;
+  const Program *program;
+  const Real32 *inputs;
+  Size input;
+  Uint64 begin;
+  Uint64 end;
+  Uint64 next; ///< Next chunk, taken atomically.
+  Uint64 stop; ///< Lowest input a trap aborted at, lowered atomically.
+  SweepThread *pool;
+  Size threads;
+};
+
+// What one chunk added, held back until every chunk below it is finished.
+// Only then is it known whether an abort below puts it past the stop.
+struct SweepChunk {
+  Uint64 chunk;
+  SweepResult result;
+  Context ctx;
+};
+
+#define SWEEP_DONE LIT64(0xffffffffffffffff)
+
+struct SweepThread {
+  SweepShared *shared;
+  pthread_t thread;
+  Uint64 chunk;    ///< At most the chunk in progress, SWEEP_DONE once done.
+  SweepResult result;
+  Context ctx;     ///< Checks and stats of every chunk below the stop.
+  ARRAY(SweepChunk) pending; ///< Chunks held back, in increasing order.
+  Bool ok;
+};
+
+// Exception flags in the order they are counted by SweepResult.
+static const char *EXCEPTIONS[] = {
+  "INEXACT",   // EXCEPTION_INEXACT
+  "UNDERFLOW", // EXCEPTION_UNDERFLOW
+  "OVERFLOW",  // EXCEPTION_OVERFLOW
+  "INFINITE",  // EXCEPTION_INFINITE
+  "INVALID"    // EXCEPTION_INVALID
+};
+
+// Errors are never negative so the magnitude bits order them, with NaN
+// ordered above infinity.
+static inline Uint32 eps_key(Float32 eps) {
+  return eps.bits & LIT32(0x7fffffff);
+}
+
+// Map float bits onto an ordered integer line where adjacent values differ
+// by one ULP, and back again.
+static inline Sint64 float32_to_ordered(Float32 x) {
+  const Sint64 magnitude = x.bits & LIT32(0x7fffffff);
+  return float32_sign(x) ? -magnitude : magnitude;
+}
+
+static inline Float32 float32_from_ordered(Sint64 x) {
+  return x < 0
+    ? (Float32){LIT32(0x80000000) | (Uint32)-x}
+    : (Float32){(Uint32)x};
+}
+
+// Inputs of a linear sweep are only chosen here, not inspected, so they are
+// generated with host arithmetic.
+static inline Float32 float32_from_host(double x) {
+  union { float h; Float32 s; } u = {(float)x};
+  return u.s;
+}
+
+void sweep_result_init(SweepResult *result) {
+  result->count = 0;
+  result->max_eps = FLOAT32_ZERO;
+  for (Size i = 0; i < sizeof result->exceptions / sizeof *result->exceptions; i++) {
+    result->exceptions[i] = 0;
+  }
+  result->n_worst = 0;
+  result->aborted = false;
+}
+
+void sweep_result_add(SweepResult *result, Float32 input, Real32 value, Exception raised) {
+  result->count++;
+
+  const Uint32 key = eps_key(value.eps);
+  if (key > eps_key(result->max_eps)) {
+    result->max_eps = value.eps;
+  }
+
+  for (Size i = 0; i < sizeof result->exceptions / sizeof *result->exceptions; i++) {
+    if ((raised & (1 << i)) && !result->exceptions[i]++) {
+      result->first[i] = input;
+    }
+  }
+
+  // Insert into the worst inputs keeping them ordered by error.
+  Size i = result->n_worst;
+  if (i == SWEEP_WORST) {
+    if (key <= eps_key(result->worst[i - 1].result.eps)) {
+      return;
+    }
+    i--;
+  } else {
+    result->n_worst++;
+  }
+  for (; i && key > eps_key(result->worst[i - 1].result.eps); i--) {
+    result->worst[i] = result->worst[i - 1];
+  }
+  result->worst[i] = (SweepWorst){input, value};
+}
+
+// Orders worst inputs by error, then by bit pattern.
+static inline Bool worse(const SweepWorst *a, const SweepWorst *b) {
+  const Uint32 a_key = eps_key(a->result.eps);
+  const Uint32 b_key = eps_key(b->result.eps);
+  return a_key > b_key || (a_key == b_key && a->input.bits < b->input.bits);
+}
+
+void sweep_result_merge(SweepResult *dst, const SweepResult *src) {
+  dst->count += src->count;
+
+  if (eps_key(src->max_eps) > eps_key(dst->max_eps)) {
+    dst->max_eps = src->max_eps;
+  }
+
+  for (Size i = 0; i < sizeof dst->exceptions / sizeof *dst->exceptions; i++) {
+    if (src->exceptions[i]) {
+      if (!dst->exceptions[i] || src->first[i].bits < dst->first[i].bits) {
+        dst->first[i] = src->first[i];
+      }
+      dst->exceptions[i] += src->exceptions[i];
+    }
+  }
+
+  SweepWorst worst[SWEEP_WORST];
+  Size n = 0, i = 0, j = 0;
+  while (n < SWEEP_WORST && (i < dst->n_worst || j < src->n_worst)) {
+    if (j == src->n_worst || (i < dst->n_worst && worse(&dst->worst[i], &src->worst[j]))) {
+      worst[n++] = dst->worst[i++];
+    } else {
+      worst[n++] = src->worst[j++];
+    }
+  }
+  for (i = 0; i < n; i++) {
+    dst->worst[i] = worst[i];
+  }
+  dst->n_worst = n;
+
+  if (src->aborted && (!dst->aborted || src->abort_input.bits < dst->abort_input.bits)) {
+    dst->aborted = true;
+    dst->abort_input = src->abort_input;
+  }
+}
+
+// Returns false when a trap aborted, [x] is then where the sweep stops rather
+// than an evaluation.
+static Bool evaluate(Context *ctx, const Program *program, Real32 *inputs, Real32 *registers, Size input, Float32 x, SweepResult *result) {
+  inputs[input] = (Real32){x, {0}};
+  context_reset(ctx);
+  const Real32 value = program_eval32(ctx, program, inputs, registers);
+  if (ctx->aborted) {
+    result->aborted = true;
+    result->abort_input = x;
+    return false;
+  }
+  sweep_result_add(result, x, value, ctx->raised);
+  return true;
+}
+
+Bool sweep_run(Context *ctx, const Program *program, Real32 *inputs, const Sweep *sweep, SweepResult *result) {
+  if (sweep->kind == SWEEP_BITS) {
+    return sweep_bits(ctx, program, inputs, sweep->input, sweep->bits_begin, sweep->bits_end, sweep->threads, result);
+  }
+
+  Real32 *registers = malloc(program_size(program) * sizeof *registers);
+  if (!registers) {
+    return false;
+  }
+
+  switch (sweep->kind) {
+  case SWEEP_LINEAR: {
+    const double start = float32_cast(sweep->start);
+    const double end = float32_cast(sweep->end);
+    const Uint64 intervals = sweep->count > 1 ? sweep->count - 1 : 1;
+    for (Uint64 i = 0; i < sweep->count; i++) {
+      const Float32 x = float32_from_host(start + (end - start) * i / intervals);
+      if (!evaluate(ctx, program, inputs, registers, sweep->input, x, result)) {
+        break;
+      }
+    }
+    break;
+  }
+  case SWEEP_ULP: {
+    Sint64 x = float32_to_ordered(sweep->start);
+    for (Uint64 i = 0; i < sweep->count; i++, x += sweep->step) {
+      if (x < -(Sint64)LIT32(0x7fffffff) || x > (Sint64)LIT32(0x7fffffff)) {
+        break;
+      }
+      if (!evaluate(ctx, program, inputs, registers, sweep->input, float32_from_ordered(x), result)) {
+        break;
+      }
+    }
+    break;
+  }
+  case SWEEP_BITS: // handled above
+    break;
+  case SWEEP_FILE: {
+    Float32 chunk[1024];
+    Size n;
+    while (!result->aborted && (n = fread(chunk, sizeof *chunk, sizeof chunk / sizeof *chunk, sweep->fp))) {
+      for (Size i = 0; i < n; i++) {
+        if (!evaluate(ctx, program, inputs, registers, sweep->input, chunk[i], result)) {
+          break;
+        }
+      }
+    }
+    break;
+  }
+  }
+
+  free(registers);
+  return true;
+}
+
+static void stop_at(SweepShared *shared, Uint64 bits) {
+  Uint64 stop = __atomic_load_n(&shared->stop, __ATOMIC_RELAXED);
+  while (bits < stop && !__atomic_compare_exchange_n(&shared->stop, &stop, bits, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    // Empty.
+  }
+}
+
+// Every chunk below the one returned is finished. A thread publishes a chunk
+// no higher than the next one before taking it, so none is ever missed.
+static Uint64 sweep_finished(const SweepShared *shared) {
+  Uint64 low = SWEEP_DONE;
+  for (Size i = 0; i < shared->threads; i++) {
+    const Uint64 chunk = __atomic_load_n(&shared->pool[i].chunk, __ATOMIC_SEQ_CST);
+    low = chunk < low ? chunk : low;
+  }
+  return low;
+}
+
+// Merge the chunks [thread] held back below [low] that start at or below the
+// stop, the one starting there aborted at its first input, and drop the others
+// there, which only ran because they were taken before an abort below them.
+// Aborts below [low] are all in the stop by now.
+static void sweep_settle(SweepThread *thread, Uint64 low) {
+  const SweepShared *shared = thread->shared;
+  const Uint64 stop = __atomic_load_n(&shared->stop, __ATOMIC_SEQ_CST);
+  Size kept = 0;
+  for (Size i = 0; i < array_size(thread->pending); i++) {
+    SweepChunk *chunk = &thread->pending[i];
+    if (chunk->chunk >= low) {
+      thread->pending[kept++] = *chunk;
+      continue;
+    }
+    if (shared->begin + chunk->chunk * SWEEP_CHUNK <= stop) {
+      sweep_result_merge(&thread->result, &chunk->result);
+      context_merge(&thread->ctx, &chunk->ctx);
+    }
+    context_free(&chunk->ctx);
+  }
+  if (thread->pending) {
+    array_meta(thread->pending)->size = kept;
+  }
+}
+
+static void *sweep_thread(void *data) {
+  SweepThread *thread = data;
+  SweepShared *shared = thread->shared;
+
+  // The tally only merges, but the forks of it evaluate and trap like [ctx].
+  Context *tally = &thread->ctx;
+  context_copy(tally, shared->ctx);
+  tally->config.traps = shared->ctx->config.traps;
+
+  // Registers followed by a private copy of the inputs.
+  const Size size = program_size(shared->program);
+  Real32 *registers = malloc((size + shared->program->inputs) * sizeof *registers);
+  if (!registers) {
+    __atomic_store_n(&thread->chunk, SWEEP_DONE, __ATOMIC_SEQ_CST);
+    return NULL;
+  }
+  Real32 *inputs = registers + size;
+  for (Size i = 0; i < shared->program->inputs; i++) {
+    inputs[i] = shared->inputs[i];
+  }
+
+  Bool ok = true;
+  for (;;) {
+    __atomic_store_n(&thread->chunk, __atomic_load_n(&shared->next, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+    const Uint64 chunk = __atomic_fetch_add(&shared->next, 1, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&thread->chunk, chunk, __ATOMIC_SEQ_CST);
+    sweep_settle(thread, sweep_finished(shared));
+    const Uint64 begin = shared->begin + chunk * SWEEP_CHUNK;
+    if (begin >= shared->end || begin >= __atomic_load_n(&shared->stop, __ATOMIC_RELAXED)) {
+      break;
+    }
+    const Uint64 end = shared->end - begin < SWEEP_CHUNK ? shared->end : begin + SWEEP_CHUNK;
+    // A fork per chunk, so what HARDWARE_CHECK samples depends on the chunk and
+    // not on the thread that took it. Only what outlives context_reset is
+    // merged, the rest is about the last input alone. A chunk that an abort
+    // below puts past the stop is dropped anyway, so it stops there too.
+    SweepChunk pending;
+    pending.chunk = chunk;
+    sweep_result_init(&pending.result);
+    context_fork(&pending.ctx, tally, chunk);
+    for (Uint64 bits = begin; bits < end && bits < __atomic_load_n(&shared->stop, __ATOMIC_RELAXED); bits++) {
+      if (!evaluate(&pending.ctx, shared->program, inputs, registers, shared->input, (Float32){bits}, &pending.result)) {
+        stop_at(shared, bits);
+        break;
+      }
+    }
+    context_reset(&pending.ctx);
+    if (!array_push(thread->pending, pending)) {
+      context_free(&pending.ctx);
+      ok = false;
+      break;
+    }
+  }
+
+  free(registers);
+  thread->ok = ok;
+  __atomic_store_n(&thread->chunk, SWEEP_DONE, __ATOMIC_SEQ_CST);
+  return NULL;
+}
+
+Bool sweep_bits(Context *ctx, const Program *program, const Real32 *inputs, Size input, Uint64 begin, Uint64 end, Size threads, SweepResult *result) {
+  SweepThread *pool = malloc(threads * sizeof *pool);
+  if (!pool) {
+    return false;
+  }
+  SweepShared shared = { ctx, program, inputs, input, begin, end, 0, end, pool, threads };
+
+  // Nothing is settled until every thread has published its first chunk.
+  for (Size i = 0; i < threads; i++) {
+    pool[i].shared = &shared;
+    pool[i].chunk = 0;
+    pool[i].pending = NULL;
+    pool[i].ok = false;
+    sweep_result_init(&pool[i].result);
+  }
+  Size started = 0;
+  for (; started < threads; started++) {
+    if (pthread_create(&pool[started].thread, NULL, sweep_thread, &pool[started])) {
+      break;
+    }
+  }
+  for (Size i = started; i < threads; i++) {
+    __atomic_store_n(&pool[i].chunk, SWEEP_DONE, __ATOMIC_SEQ_CST);
+  }
+
+  Bool ok = started != 0;
+  for (Size i = 0; i < started; i++) {
+    pthread_join(pool[i].thread, NULL);
+  }
+  // Every chunk is finished and the stop is final.
+  for (Size i = 0; i < started; i++) {
+    ok = ok && pool[i].ok;
+    if (pool[i].ok) {
+      sweep_settle(&pool[i], SWEEP_DONE);
+      context_merge(ctx, &pool[i].ctx);
+      context_free(&pool[i].ctx);
+    }
+    array_free(pool[i].pending);
+    sweep_result_merge(result, &pool[i].result);
+  }
+
+  free(pool);
+  return ok;
+}
+
+static void sweep_print_text(Writer *writer, const char *name, const SweepResult *result) {
+  writer_printf(writer, "evaluations: %llu\n", (unsigned long long)result->count);
+  writer_string(writer, "    max err: ");
+  writer_float32(writer, result->max_eps);
+  writer_char(writer, '\n');
+  for (Size i = 0; i < sizeof result->exceptions / sizeof *result->exceptions; i++) {
+    writer_printf(writer, "  %9s: %llu", EXCEPTIONS[i], (unsigned long long)result->exceptions[i]);
+    if (result->exceptions[i]) {
+      writer_printf(writer, " (first %s = ", name);
+      writer_float32(writer, result->first[i]);
+      writer_printf(writer, " (0x%08x))", (unsigned)result->first[i].bits);
+    }
+    writer_char(writer, '\n');
+  }
+  for (Size i = 0; i < result->n_worst; i++) {
+    const SweepWorst *worst = &result->worst[i];
+    writer_printf(writer, "%s = ", name);
+    writer_float32(writer, worst->input);
+    writer_printf(writer, " (0x%08x)\n\tans: ", (unsigned)worst->input.bits);
+    writer_float32(writer, worst->result.value);
+    writer_string(writer, "\n\terr: ");
+    writer_float32(writer, worst->result.eps);
+    writer_char(writer, '\n');
+  }
+  if (result->aborted) {
+    writer_printf(writer, "aborted at %s = ", name);
+    writer_float32(writer, result->abort_input);
+    writer_printf(writer, " (0x%08x)\n", (unsigned)result->abort_input.bits);
+  }
+}
+
+// Records of "evaluations\tCOUNT", "max_err\tERR", "FLAG\tCOUNT\tFIRST" and
+// "worst\tINPUT\tANS\tERR" with inputs as bit patterns, then "aborted\tINPUT"
+// when a trap stopped the sweep.
+static void sweep_print_tsv(Writer *writer, const SweepResult *result) {
+  writer_printf(writer, "evaluations\t%llu\n", (unsigned long long)result->count);
+  writer_string(writer, "max_err\t");
+  writer_float32(writer, result->max_eps);
+  writer_char(writer, '\n');
+  for (Size i = 0; i < sizeof result->exceptions / sizeof *result->exceptions; i++) {
+    writer_printf(writer, "%s\t%llu\t", EXCEPTIONS[i], (unsigned long long)result->exceptions[i]);
+    if (result->exceptions[i]) {
+      writer_printf(writer, "0x%08x", (unsigned)result->first[i].bits);
+    }
+    writer_char(writer, '\n');
+  }
+  for (Size i = 0; i < result->n_worst; i++) {
+    const SweepWorst *worst = &result->worst[i];
+    writer_printf(writer, "worst\t0x%08x\t", (unsigned)worst->input.bits);
+    writer_float32(writer, worst->result.value);
+    writer_char(writer, '\t');
+    writer_float32(writer, worst->result.eps);
+    writer_char(writer, '\n');
+  }
+  if (result->aborted) {
+    writer_printf(writer, "aborted\t0x%08x\n", (unsigned)result->abort_input.bits);
+  }
+}
+
+static void sweep_print_json(Writer *writer, const char *name, const SweepResult *result) {
+  writer_string(writer, "{\"input\":");
+  writer_json_string(writer, name);
+  writer_printf(writer, ",\"evaluations\":%llu,\"max_err\":", (unsigned long long)result->count);
+  writer_json_float32(writer, result->max_eps);
+  writer_string(writer, ",\"exceptions\":{");
+  for (Size i = 0; i < sizeof result->exceptions / sizeof *result->exceptions; i++) {
+    writer_printf(writer, "%s\"%s\":{\"count\":%llu",
+      i ? "," : "",
+      EXCEPTIONS[i],
+      (unsigned long long)result->exceptions[i]);
+    if (result->exceptions[i]) {
+      writer_printf(writer, ",\"first\":%u", (unsigned)result->first[i].bits);
+    }
+    writer_char(writer, '}');
+  }
+  writer_string(writer, "},\"worst\":[");
+  for (Size i = 0; i < result->n_worst; i++) {
+    const SweepWorst *worst = &result->worst[i];
+    writer_printf(writer, "%s{\"input\":%u,\"ans\":", i ? "," : "", (unsigned)worst->input.bits);
+    writer_json_float32(writer, worst->result.value);
+    writer_string(writer, ",\"err\":");
+    writer_json_float32(writer, worst->result.eps);
+    writer_char(writer, '}');
+  }
+  writer_char(writer, ']');
+  if (result->aborted) {
+    writer_printf(writer, ",\"aborted\":%u", (unsigned)result->abort_input.bits);
+  }
+  writer_string(writer, "}\n");
+}
+
+void sweep_print(Writer *writer, const char *name, const SweepResult *result) {
+  switch (writer->format) {
+  case FORMAT_TEXT:
+    sweep_print_text(writer, name, result);
+    break;
+  case FORMAT_TSV:
+    sweep_print_tsv(writer, result);
+    break;
+  case FORMAT_JSON:
+    sweep_print_json(writer, name, result);
+    break;
+  }
+}
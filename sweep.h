@@ -0,0 +1,85 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+#include <stdio.h> // FILE
+
+#include "program.h"
+#include "writer.h"
+
+// Evaluation of a compiled program over many values of one of its inputs.
+//
+// The per-input cost is the evaluation of the program itself, results are
+// reduced into a SweepResult as they are produced instead of being reported
+// individually.
+typedef enum SweepKind SweepKind;
+
+typedef struct Sweep Sweep;
+typedef struct SweepWorst SweepWorst;
+typedef struct SweepResult SweepResult;
+
+enum SweepKind {
+  SWEEP_LINEAR, ///< [count] values evenly spaced over [start, end].
+  SWEEP_ULP,    ///< [count] values from [start] stepping [step] ULPs each.
+  SWEEP_FILE,   ///< Native float32 values read from [fp] until end of file.
+  SWEEP_BITS    ///< Every bit pattern in [bits_begin, bits_end) across [threads].
+};
+
+struct Sweep {
+  SweepKind kind;
+  Size input;    ///< Index of the swept program input.
+  Float32 start;
+  Float32 end;
+  Uint64 count;
+  Sint32 step;
+  FILE *fp;
+  Uint64 bits_begin;
+  Uint64 bits_end;
+  Size threads;
+};
+
+struct SweepWorst {
+  Float32 input;
+  Real32 result;
+};
+
+// Number of worst inputs kept in a SweepResult.
+#define SWEEP_WORST 8
+
+struct SweepResult {
+  Uint64 count;                ///< Number of evaluations.
+  Float32 max_eps;             ///< Largest accumulated error of any result.
+  Uint64 exceptions[5];        ///< Evaluations raising each exception flag.
+  Float32 first[5];            ///< First input raising each exception flag.
+  Size n_worst;
+  SweepWorst worst[SWEEP_WORST]; ///< Largest error first.
+  Bool aborted;                ///< A trap stopped the sweep.
+  Float32 abort_input;         ///< Lowest input a trap aborted at.
+};
+
+void sweep_result_init(SweepResult*);
+
+// Accumulate one evaluation of [input] into [result].
+void sweep_result_add(SweepResult*, Float32 input, Real32 value, Exception raised);
+
+// Combine [src] into [dst]. Ties in error and the first input raising a flag
+// are resolved towards the lower bit pattern, so merging the per-thread
+// results of sweep_bits does not depend on how the threads were scheduled.
+void sweep_result_merge(SweepResult *dst, const SweepResult *src);
+
+// Run [sweep] over [program], [inputs] provides the values of every other
+// program input and is used as scratch for the swept one. A trap handler of
+// [ctx] that aborts stops the sweep at that input, which is not counted.
+Bool sweep_run(Context*, const Program*, Real32 *inputs, const Sweep*, SweepResult*);
+
+// Evaluate [program] for every bit pattern in [begin, end) of input [input]
+// across [threads] threads, each with its own copy of [ctx]. Passing a range
+// of [0, 2^32) sweeps every float32 value. The checks done by the copies are
+// added to [ctx]. Once a trap aborts, the results and checks cover exactly the
+// inputs below the lowest one it aborted at, however the threads were
+// scheduled: chunks above it are skipped, cut short or dropped.
+Bool sweep_bits(Context *ctx, const Program*, const Real32 *inputs, Size input, Uint64 begin, Uint64 end, Size threads, SweepResult*);
+
+// Print [result] for a sweep over the input named [name], in the format of
+// [writer].
+void sweep_print(Writer*, const char *name, const SweepResult*);
+
+#endif // SWEEP_H
@@ -0,0 +1,113 @@
+#include <stdio.h> // printf
+
+#include "batch32.h"
+
+// The batch functions against a loop over the scalar ones, in every rounding
+// and tininess mode, over inputs that take both the vector and scalar lanes.
+
+typedef Float32 (*Scalar)(Context*, Float32, Float32);
+typedef void (*Batch)(Context*, Size, const Float32*, const Float32*, Float32*, Uint8*);
+
+#define COUNT 4099 // Not a multiple of any vector width.
+
+static const struct {
+  const char *name;
+  Scalar scalar;
+  Batch batch;
+} OPS[] = {
+  { "add", float32_add, float32_add_batch },
+  { "sub", float32_sub, float32_sub_batch },
+  { "mul", float32_mul, float32_mul_batch },
+  { "div", float32_div, float32_div_batch },
+};
+
+static Uint32 seed = 0x9e3779b9;
+
+static Uint32 next(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+// Mostly normals of similar magnitude, with zeros, subnormals, infinities,
+// NaNs and values near the ends of the range mixed in.
+static Float32 input(void) {
+  static const Uint32 SPECIAL[] = {
+    LIT32(0x00000000), LIT32(0x80000000), LIT32(0x00000001), LIT32(0x807fffff),
+    LIT32(0x00800000), LIT32(0x7f7fffff), LIT32(0xff7fffff), LIT32(0x7f800000),
+    LIT32(0xff800000), LIT32(0x7fc00000), LIT32(0x7f800001), LIT32(0xffffffff),
+  };
+  const Uint32 r = next();
+  switch (r % 16) {
+  case 0:
+    return (Float32){SPECIAL[next() % (sizeof SPECIAL / sizeof *SPECIAL)]};
+  case 1:
+    return (Float32){next() & LIT32(0x807fffff)}; // subnormal
+  case 2:
+    return (Float32){next()}; // anything
+  default:
+    return (Float32){(next() & LIT32(0x83ffffff)) | LIT32(0x3c000000)};
+  }
+}
+
+static Size check(Round round, Tininess tininess, Size op) {
+  static Float32 a[COUNT], b[COUNT], r[COUNT];
+  static Uint8 exceptions[COUNT];
+  for (Size i = 0; i < COUNT; i++) {
+    a[i] = input();
+    b[i] = input();
+  }
+
+  Context ctx;
+  ctx.config.round = round;
+  ctx.config.tininess = tininess;
+  ctx.config.hardware = HARDWARE_NONE;
+  ctx.config.bound = BOUND_FLOAT;
+  ctx.config.capacity = 0;
+  ctx.config.traps = NULL;
+  context_init(&ctx);
+  OPS[op].batch(&ctx, COUNT, a, b, r, exceptions);
+  const Size batch_roundings = ctx.roundings;
+
+  Size failures = 0;
+  Size roundings = 0;
+  for (Size i = 0; i < COUNT; i++) {
+    context_reset(&ctx);
+    const Float32 s = OPS[op].scalar(&ctx, a[i], b[i]);
+    roundings += ctx.roundings;
+    if (s.bits != r[i].bits || ctx.raised != exceptions[i]) {
+      if (failures++ < 4) {
+        printf("FAIL %s round %d tininess %d: %08x, %08x gave %08x/%02x, scalar %08x/%02x\n",
+          OPS[op].name, round, tininess,
+          (unsigned)a[i].bits, (unsigned)b[i].bits,
+          (unsigned)r[i].bits, exceptions[i],
+          (unsigned)s.bits, ctx.raised);
+      }
+    }
+  }
+  if (roundings != batch_roundings) {
+    printf("FAIL %s round %d tininess %d: %zu roundings, scalar %zu\n",
+      OPS[op].name, round, tininess, batch_roundings, roundings);
+    failures++;
+  }
+  context_free(&ctx);
+  return failures;
+}
+
+int main(void) {
+  Size failures = 0;
+  Size cases = 0;
+  for (int round = ROUND_NEAREST_EVEN; round <= ROUND_UP; round++) {
+    for (int tininess = 0; tininess < 2; tininess++) {
+      for (Size op = 0; op < sizeof OPS / sizeof *OPS; op++) {
+        for (Size pass = 0; pass < 8; pass++) {
+          failures += check(round, tininess, op);
+          cases += COUNT;
+        }
+      }
+    }
+  }
+  printf("batch32: %zu cases, %zu failures\n", cases, failures);
+  return failures != 0;
+}
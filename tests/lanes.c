@@ -0,0 +1,94 @@
+#include <stdio.h> // printf
+
+#include "eval.h"
+
+// Expressions parsed in each of the eight rounding and tininess modes must
+// compile to the same instructions, differing only in what they load, and
+// evaluating those in lanes must give what evaluating each on its own does,
+// the way -a stands in for eight runs with -r and -t.
+
+enum { LANES = 8 };
+
+static void init(Context *ctx, Size lane) {
+  ctx->config.round = lane / 2;
+  ctx->config.tininess = lane % 2;
+  ctx->config.hardware = HARDWARE_NONE;
+  ctx->config.bound = BOUND_FLOAT;
+  ctx->config.capacity = 0;
+  ctx->config.traps = NULL;
+  context_init(ctx);
+}
+
+int main(void) {
+  static const char *const EXPRESSIONS[] = {
+    "0.1",
+    "0.1*x+0.10*x",
+    "0.1+0.1+0.1000000015",
+    "sqrt(x)/3e-39+1e39",
+    "1.17549425e-38*0.5-x",
+    "fma(x,0.3,x*0.3);0.3",
+  };
+  const Size n_expressions = sizeof EXPRESSIONS / sizeof *EXPRESSIONS;
+  Size cases = 0;
+  Size failures = 0;
+
+  for (Size i = 0; i < n_expressions; i++) {
+    Context ctx[LANES];
+    Program programs[LANES];
+    Real32 inputs[LANES * EXPR_MAX_VARIABLES];
+    Real32 expected[LANES];
+    Exception raised[LANES];
+    Bool same = true;
+    for (Size l = 0; l < LANES; l++) {
+      init(&ctx[l], l);
+      Expression *e;
+      if (!expr_parse(&e, &ctx[l], EXPRESSIONS[i]) || !expr_compile(&programs[l], e)) {
+        printf("lanes: cannot compile %s\n", EXPRESSIONS[i]);
+        return 1;
+      }
+      for (Size v = 0; v < expr_variables(e); v++) {
+        expr_parse_value(&ctx[l], "0.7", &inputs[l * expr_variables(e) + v]);
+        expr_bind(e, v, inputs[l * expr_variables(e) + v]);
+      }
+      expected[l] = expr_eval32(&ctx[l], e, NULL);
+      raised[l] = ctx[l].raised;
+      context_reset(&ctx[l]);
+      expr_free(e);
+    }
+    // OP_LOAD may raise different flags in each mode, nothing else differs.
+    for (Size l = 1; l < LANES; l++) {
+      same = same && array_size(programs[l].code) == array_size(programs[0].code);
+      for (Size n = 0; same && n < array_size(programs[0].code); n++) {
+        const Instruction *a = &programs[0].code[n];
+        const Instruction *b = &programs[l].code[n];
+        same = a->op == b->op && a->a == b->a && (a->op == OP_LOAD || a->b == b->b) && a->c == b->c;
+      }
+    }
+    if (!same) {
+      printf("lanes: %s compiles differently across modes\n", EXPRESSIONS[i]);
+      failures++;
+    }
+
+    Real32 registers[64 * LANES];
+    Real32 results[LANES];
+    if (same && program_size(&programs[0]) <= 64) {
+      program_eval32_lanes(ctx, LANES, programs, inputs, registers, results);
+      for (Size l = 0; l < LANES; l++) {
+        if (results[l].value.bits != expected[l].value.bits || results[l].eps.bits != expected[l].eps.bits || ctx[l].raised != raised[l]) {
+          printf("lanes: %s in lane %zu gave %08x %08x %02x instead of %08x %08x %02x\n",
+            EXPRESSIONS[i], l, (unsigned)results[l].value.bits, (unsigned)results[l].eps.bits, (unsigned)ctx[l].raised,
+            (unsigned)expected[l].value.bits, (unsigned)expected[l].eps.bits, (unsigned)raised[l]);
+          failures++;
+        }
+        cases++;
+      }
+    }
+    for (Size l = 0; l < LANES; l++) {
+      program_free(&programs[l]);
+      context_free(&ctx[l]);
+    }
+  }
+
+  printf("lanes: %zu cases, %zu failures\n", cases, failures);
+  return failures != 0;
+}
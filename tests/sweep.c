@@ -0,0 +1,81 @@
+#include <stdio.h> // printf
+
+#include "eval.h"
+#include "sweep.h"
+
+// Bit pattern sweeps that a trap aborts, with the abort at the first input of
+// a chunk, in the middle of one and right at the beginning of the sweep. Each
+// must report the abort and count exactly the inputs below it, for any number
+// of threads.
+
+typedef struct Case Case;
+
+struct Case {
+  const char *expression;
+  Uint64 begin;
+  Uint64 end;
+  Uint32 abort; ///< First input that traps.
+};
+
+static TrapAction trap_abort(Trap *trap, void *data) {
+  (void)trap;
+  (void)data;
+  return TRAP_ABORT;
+}
+
+int main(void) {
+  // 0x1.fffep-134 is the bit pattern 0x0000ffff, so x above it is invalid.
+  static const Case CASES[] = {
+    { "sqrt(0x1.fffep-134 - x)", 0, 0x30000, 0x10000 },
+    { "sqrt(0x1.fffep-134 - x)", 0x8000, 0x28000, 0x10000 },
+    { "sqrt(0x1.ffep-138 - x)", 0, 0x20000, 0x1000 },
+    { "sqrt(0-x)", 0x3f800000, 0x3f800010, 0x3f800000 },
+  };
+  const Size n_cases = sizeof CASES / sizeof *CASES;
+  Size cases = 0;
+  Size failures = 0;
+
+  Traps traps = { { NULL }, NULL };
+  traps.handlers[4] = trap_abort; // EXCEPTION_INVALID
+
+  for (Size i = 0; i < n_cases; i++) {
+    const Case *c = &CASES[i];
+    for (Size threads = 1; threads <= 4; threads++) {
+      Context ctx;
+      ctx.config.round = ROUND_NEAREST_EVEN;
+      ctx.config.tininess = TININESS_BEFORE_ROUNDING;
+      ctx.config.hardware = HARDWARE_NONE;
+      ctx.config.bound = BOUND_FLOAT;
+      ctx.config.capacity = 0;
+      ctx.config.traps = &traps;
+      context_init(&ctx);
+
+      Expression *e;
+      Program program;
+      Size input;
+      if (!expr_parse(&e, &ctx, c->expression) || !expr_find_variable(e, "x", &input) || !expr_compile(&program, e)) {
+        printf("sweep: cannot compile %s\n", c->expression);
+        return 1;
+      }
+      Real32 inputs[EXPR_MAX_VARIABLES] = { REAL32_ZERO };
+      SweepResult result;
+      sweep_result_init(&result);
+      const Bool ok = sweep_bits(&ctx, &program, inputs, input, c->begin, c->end, threads, &result);
+      program_free(&program);
+      expr_free(e);
+      context_free(&ctx);
+
+      if (!ok || !result.aborted || result.abort_input.bits != c->abort || result.count != c->abort - c->begin) {
+        printf("sweep: %s over [%#llx, %#llx) on %zu threads counted %llu, %s at %#x\n",
+          c->expression, (unsigned long long)c->begin, (unsigned long long)c->end, threads,
+          (unsigned long long)result.count, result.aborted ? "aborted" : "not aborted",
+          (unsigned)result.abort_input.bits);
+        failures++;
+      }
+      cases++;
+    }
+  }
+
+  printf("sweep: %zu cases, %zu failures\n", cases, failures);
+  return failures != 0;
+}
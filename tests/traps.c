@@ -0,0 +1,104 @@
+#include <stdio.h> // printf
+
+#include "eval.h"
+
+// Expressions evaluated with a single flag trapped by a handler that logs
+// every trap and continues. Each must trap exactly once, as the operation the
+// expression names with its own operands, kernels included, and compiled must
+// trap at the same node.
+
+typedef struct Case Case;
+
+struct Case {
+  const char *expression;
+  Exception exception;
+  Operation operation;
+  Float32 operand;
+  Float32 result;
+};
+
+static Trap traps[8];
+static Size n_traps;
+
+static TrapAction record(Trap *trap, void *data) {
+  (void)data;
+  if (n_traps < sizeof traps / sizeof *traps) {
+    traps[n_traps] = *trap;
+  }
+  n_traps++;
+  return TRAP_CONTINUE;
+}
+
+int main(void) {
+  static const Case CASES[] = {
+    { "sqrt(0-1)",   EXCEPTION_INVALID,  OPERATION_SQRT,  {LIT32(0xbf800000)}, {LIT32(0xffffffff)} },
+    { "1+sqrt(0-1)", EXCEPTION_INVALID,  OPERATION_SQRT,  {LIT32(0xbf800000)}, {LIT32(0xffffffff)} },
+    { "sqrt(2)",     EXCEPTION_INEXACT,  OPERATION_SQRT,  {LIT32(0x40000000)}, {LIT32(0x3fb504f3)} },
+    { "floor(2.5)",  EXCEPTION_INEXACT,  OPERATION_FLOOR, {LIT32(0x40200000)}, {LIT32(0x40000000)} },
+    { "ceil(2.5)",   EXCEPTION_INEXACT,  OPERATION_CEIL,  {LIT32(0x40200000)}, {LIT32(0x40400000)} },
+    { "trunc(2.5)",  EXCEPTION_INEXACT,  OPERATION_TRUNC, {LIT32(0x40200000)}, {LIT32(0x40000000)} },
+    { "1/0",         EXCEPTION_INFINITE, OPERATION_DIV,   {LIT32(0x3f800000)}, {LIT32(0x7f800000)} },
+  };
+  const Size n_cases = sizeof CASES / sizeof *CASES;
+  Size failures = 0;
+
+  for (Size i = 0; i < n_cases; i++) {
+    const Case *c = &CASES[i];
+    Traps handlers = { { NULL }, NULL };
+    for (Size f = 0; f < 5; f++) {
+      if (c->exception == 1u << f) {
+        handlers.handlers[f] = record;
+      }
+    }
+
+    Context ctx;
+    ctx.config.round = ROUND_NEAREST_EVEN;
+    ctx.config.tininess = TININESS_BEFORE_ROUNDING;
+    ctx.config.hardware = HARDWARE_NONE;
+    ctx.config.bound = BOUND_FLOAT;
+    ctx.config.capacity = 64;
+    ctx.config.traps = &handlers;
+    context_init(&ctx);
+
+    Expression *e;
+    if (!expr_parse(&e, &ctx, c->expression)) {
+      printf("traps: cannot parse %s\n", c->expression);
+      return 1;
+    }
+    n_traps = 0;
+    expr_eval32(&ctx, e, NULL);
+    const Trap t0 = traps[0];
+    const Size n_interpreted = n_traps;
+
+    Program program;
+    Real32 registers[64];
+    if (!expr_compile(&program, e) || program_size(&program) > 64) {
+      printf("traps: cannot compile %s\n", c->expression);
+      return 1;
+    }
+    n_traps = 0;
+    context_reset(&ctx);
+    program_eval32(&ctx, &program, NULL, registers);
+    if (n_traps != n_interpreted || traps[0].node != t0.node) {
+      printf("traps: %s compiled trapped %zu times at #%u instead of %zu at #%u\n",
+        c->expression, n_traps, (unsigned)traps[0].node, n_interpreted, (unsigned)t0.node);
+      failures++;
+    }
+    program_free(&program);
+    expr_free(e);
+    context_free(&ctx);
+
+    const Trap *t = &t0;
+    if (n_interpreted != 1 || t->exception != c->exception || t->operation != c->operation
+      || t->operands[0].bits != c->operand.bits || t->result.bits != c->result.bits)
+    {
+      printf("traps: %s trapped %zu times, first %u %u %08x = %08x\n",
+        c->expression, n_interpreted, (unsigned)t->exception, (unsigned)t->operation,
+        (unsigned)t->operands[0].bits, (unsigned)t->result.bits);
+      failures++;
+    }
+  }
+
+  printf("traps: %zu cases, %zu failures\n", n_cases, failures);
+  return failures != 0;
+}
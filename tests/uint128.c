@@ -0,0 +1,128 @@
+#include <stdio.h> // printf
+
+#include "uint128.h"
+
+// The native and portable multiplication and division against a shift and
+// add reference over edge values and random operands. Products must agree
+// bit for bit. The native quotient must be exact, the portable estimate at
+// most 2 above it and the same once corrected the way float64 division does.
+
+static Uint64 seed = LIT64(0x9e3779b97f4a7c15);
+
+static Uint64 next(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+static Bool equal(Uint128 a, Uint128 b) {
+  return a.z0 == b.z0 && a.z1 == b.z1;
+}
+
+static Uint128 reference_mul(Uint64 a, Uint64 b) {
+  Uint128 z = { 0, 0 };
+  for (Sint16 i = 0; i < 64; i++) {
+    if ((b >> i) & 1) {
+      z = uint128_add(z, uint128_shl((Uint128){0, a}, i));
+    }
+  }
+  return z;
+}
+
+// Restoring division, saturated like the functions under test.
+static Uint64 reference_div(Uint128 a, Uint64 b) {
+  if (b <= a.z0) {
+    return LIT64(0xFFFFFFFFFFFFFFFF);
+  }
+  Uint64 r = a.z0;
+  Uint64 q = 0;
+  for (Sint16 i = 63; i >= 0; i--) {
+    const Bool carry = r >> 63;
+    r = (r << 1) | ((a.z1 >> i) & 1);
+    q <<= 1;
+    if (carry || r >= b) {
+      r -= b;
+      q |= 1;
+    }
+  }
+  return q;
+}
+
+static Size failures = 0;
+
+static void check_mul(Uint64 a, Uint64 b) {
+  const Uint128 z = reference_mul(a, b);
+  const Uint128 native = uint128_mul64x64(a, b);
+  const Uint128 portable = uint128_mul64x64_portable(a, b);
+  if (!equal(native, z) || !equal(portable, z)) {
+    if (failures++ < 8) {
+      printf("FAIL mul %016llx %016llx\n", (unsigned long long)a, (unsigned long long)b);
+    }
+  }
+}
+
+static void check_div(Uint128 a, Uint64 b) {
+  const Uint64 q = reference_div(a, b);
+  const Uint64 native = uint128_div128x64(a, b);
+  Uint64 portable = uint128_div128x64_portable(a, b);
+  Bool ok = portable >= q && portable - q <= 2;
+#if defined(UINT128_NATIVE)
+  ok = ok && native == q;
+#else
+  ok = ok && native == portable;
+#endif
+  if (b > a.z0) {
+    // Corrected as float64 division does, while the remainder is negative.
+    Uint128 rem = uint128_sub(a, uint128_mul64x64_portable(b, portable));
+    while ((Sint64)rem.z0 < 0) {
+      portable--;
+      rem = uint128_add(rem, (Uint128){0, b});
+    }
+    ok = ok && portable == q;
+  }
+  if (!ok) {
+    if (failures++ < 8) {
+      printf("FAIL div %016llx%016llx %016llx\n",
+        (unsigned long long)a.z0, (unsigned long long)a.z1, (unsigned long long)b);
+    }
+  }
+}
+
+int main(void) {
+  static const Uint64 EDGES[] = {
+    0, 1, 2, LIT64(0xFFFFFFFF), LIT64(0x100000000), LIT64(0x100000001),
+    LIT64(0x7FFFFFFFFFFFFFFF), LIT64(0x8000000000000000), LIT64(0x8000000000000001),
+    LIT64(0xFFFFFFFF00000000), LIT64(0xFFFFFFFEFFFFFFFF), LIT64(0xFFFFFFFFFFFFFFFE),
+    LIT64(0xFFFFFFFFFFFFFFFF),
+  };
+  const Size n_edges = sizeof EDGES / sizeof *EDGES;
+  Size cases = 0;
+
+  for (Size i = 0; i < n_edges; i++) {
+    for (Size j = 0; j < n_edges; j++) {
+      check_mul(EDGES[i], EDGES[j]);
+      for (Size k = 0; k < n_edges; k++) {
+        const Uint64 b = EDGES[k] | LIT64(0x8000000000000000);
+        check_div((Uint128){EDGES[i], EDGES[j]}, b);
+        check_div((Uint128){EDGES[i] % b, EDGES[j]}, b);
+        cases += 2;
+      }
+      cases++;
+    }
+  }
+
+  for (Size i = 0; i < 1000000; i++) {
+    const Uint64 a = next() >> (next() % 64);
+    const Uint64 b = next() >> (next() % 64);
+    check_mul(a, b);
+    const Uint64 d = next() | LIT64(0x8000000000000000);
+    // Mostly quotients that fit, as float64 division only makes those.
+    const Uint64 hi = i % 16 ? next() % d : next();
+    check_div((Uint128){hi, next()}, d);
+    cases += 2;
+  }
+
+  printf("uint128: %zu cases, %zu failures\n", cases, failures);
+  return failures != 0;
+}
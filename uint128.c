@@ -1,6 +1,6 @@
 #include "uint128.h"
 
-Uint128 uint128_mul64x64(Uint64 a, Uint64 b) {
+Uint128 uint128_mul64x64_portable(Uint64 a, Uint64 b) {
   const Uint32 al = a;
   const Uint32 ah = a >> 32;
   const Uint32 bl = b;
@@ -19,7 +19,7 @@ Uint128 uint128_mul64x64(Uint64 a, Uint64 b) {
   return (Uint128){z0, z1};
 }
 
-Uint64 uint128_div128x64(Uint128 a, Uint64 b) {
+Uint64 uint128_div128x64_portable(Uint128 a, Uint64 b) {
   if (b <= a.z0) {
     return LIT64(0xFFFFFFFFFFFFFFFF);
   }
@@ -30,7 +30,7 @@ Uint64 uint128_div128x64(Uint128 a, Uint64 b) {
   Uint64 z = (b0 << 32 <= a.z0)
     ? LIT64(0xFFFFFFFF00000000) : (a.z0 / b0) << 32;
 
-  Uint128 mul = uint128_mul64x64(b, z);
+  Uint128 mul = uint128_mul64x64_portable(b, z);
   Uint128 rem = uint128_sub(a, mul);
 
   while ((Sint64)rem.z0 < 0) {
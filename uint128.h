@@ -9,17 +9,59 @@ struct Uint128 {
   Uint64 z1;
 };
 
+// The multiplication and division below use the native 128-bit integer type
+// when the compiler has one, which is one or two instructions on 64-bit hosts.
+// Define UINT128_PORTABLE to build with the portable implementation instead,
+// which is always available under the _portable names.
+#if defined(__SIZEOF_INT128__) && !defined(UINT128_PORTABLE)
+#define UINT128_NATIVE
+#endif
+
 // Multiplies two 64-bit integers to obtain a 128-bit product.
-Uint128 uint128_mul64x64(Uint64 a, Uint64 b);
+Uint128 uint128_mul64x64_portable(Uint64 a, Uint64 b);
 
 // Calculate approximation to the 64-bit integer quotient obtained by dividing
-// 64-bit b into the 128-bit a. The divisor b must be at least 2^63.
-Uint64 uint128_div128x64(Uint128 a, Uint64 b);
+// 64-bit b into the 128-bit a. The divisor b must be at least 2^63. The result
+// is at most 2 more than the exact quotient, which is saturated to 2^64 - 1.
+Uint64 uint128_div128x64_portable(Uint128 a, Uint64 b);
+
+#if defined(UINT128_NATIVE)
+__extension__ typedef unsigned __int128 Uint128Native;
+
+static inline Uint128 uint128_mul64x64(Uint64 a, Uint64 b) {
+  const Uint128Native z = (Uint128Native)a * b;
+  return (Uint128){z >> 64, z};
+}
+
+// The quotient is exact here, which is within the bound of the approximation.
+static inline Uint64 uint128_div128x64(Uint128 a, Uint64 b) {
+  if (b <= a.z0) {
+    return LIT64(0xFFFFFFFFFFFFFFFF);
+  }
+#if defined(__x86_64__)
+  // The quotient fits so the instruction cannot fault, the compiler would call
+  // the full 128-bit by 128-bit library division instead.
+  Uint64 q, r;
+  __asm__("divq %4" : "=a"(q), "=d"(r) : "a"(a.z1), "d"(a.z0), "rm"(b));
+  return q;
+#else
+  return (((Uint128Native)a.z0 << 64) | a.z1) / b;
+#endif
+}
+#else
+static inline Uint128 uint128_mul64x64(Uint64 a, Uint64 b) {
+  return uint128_mul64x64_portable(a, b);
+}
+
+static inline Uint64 uint128_div128x64(Uint128 a, Uint64 b) {
+  return uint128_div128x64_portable(a, b);
+}
+#endif
 
 // Subtraction is modulo 2^128
 static inline Uint128 uint128_sub(Uint128 a, Uint128 b) {
   const Uint64 z1 = a.z1 - b.z1;
-  return (Uint128){a.z0 - b.z0 - z1, z1};
+  return (Uint128){a.z0 - b.z0 - (a.z1 < b.z1), z1};
 }
 
 // Addition is modulo 2^128
@@ -28,4 +70,51 @@ static inline Uint128 uint128_add(Uint128 a, Uint128 b) {
   return (Uint128){a.z0 + b.z0 + (z1 < a.z1), z1};
 }
 
+static inline Bool uint128_lt(Uint128 a, Uint128 b) {
+  return a.z0 < b.z0 || (a.z0 == b.z0 && a.z1 < b.z1);
+}
+
+// Shift left by [count] in [0, 128).
+static inline Uint128 uint128_shl(Uint128 a, Sint16 count) {
+  if (count == 0) {
+    return a;
+  } else if (count < 64) {
+    return (Uint128){(a.z0 << count) | (a.z1 >> (64 - count)), a.z1 << count};
+  }
+  return (Uint128){a.z1 << (count - 64), 0};
+}
+
+// Shift right by [count] in [0, 128).
+static inline Uint128 uint128_shr(Uint128 a, Sint16 count) {
+  if (count == 0) {
+    return a;
+  } else if (count < 64) {
+    return (Uint128){a.z0 >> count, (a.z0 << (64 - count)) | (a.z1 >> count)};
+  }
+  return (Uint128){0, a.z0 >> (count - 64)};
+}
+
+// Shift right where the least significant bit of the result is set when any
+// non-zero bits are shifted off.
+static inline Uint128 uint128_rshr(Uint128 a, Sint16 count) {
+  if (count == 0) {
+    return a;
+  } else if (count < 64) {
+    const Uint64 sticky = (a.z1 << (64 - count)) != 0;
+    return (Uint128){a.z0 >> count, (a.z0 << (64 - count)) | (a.z1 >> count) | sticky};
+  } else if (count < 128) {
+    const Uint64 sticky = ((count == 64 ? 0 : a.z0 << (128 - count)) | a.z1) != 0;
+    return (Uint128){0, (count == 64 ? a.z0 : a.z0 >> (count - 64)) | sticky};
+  }
+  return (Uint128){0, (a.z0 | a.z1) != 0};
+}
+
+// Count leading zero bits.
+static inline Sint16 uint128_clz(Uint128 a) {
+  if (a.z0) {
+    return __builtin_clzll(a.z0);
+  }
+  return a.z1 ? 64 + __builtin_clzll(a.z1) : 128;
+}
+
 #endif // UINT128_H
\ No newline at end of file
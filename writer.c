@@ -0,0 +1,243 @@
+#include <stdarg.h> // va_list, va_start, va_end
+#include <string.h> // memcpy, strlen
+
+#include "decimal.h"
+#include "float32.h"
+#include "writer.h"
+
+void writer_init(Writer *writer, FILE *fp, Format format) {
+  writer->fp = fp;
+  writer->format = format;
+  writer->notation = NOTATION_SHORTEST;
+  writer->length = 0;
+}
+
+Bool writer_flush(Writer *writer) {
+  const Size length = writer->length;
+  writer->length = 0;
+  if (length && fwrite(writer->buffer, 1, length, writer->fp) != length) {
+    return false;
+  }
+  return fflush(writer->fp) == 0;
+}
+
+void writer_write(Writer *writer, const char *data, Size length) {
+  if (writer->length + length > WRITER_CAPACITY) {
+    writer_flush(writer);
+    // Too large to ever be buffered, hand it straight to the stream.
+    if (length > WRITER_CAPACITY) {
+      fwrite(data, 1, length, writer->fp);
+      return;
+    }
+  }
+  memcpy(writer->buffer + writer->length, data, length);
+  writer->length += length;
+}
+
+void writer_string(Writer *writer, const char *string) {
+  writer_write(writer, string, strlen(string));
+}
+
+void writer_char(Writer *writer, char ch) {
+  if (writer->length == WRITER_CAPACITY) {
+    writer_flush(writer);
+  }
+  writer->buffer[writer->length++] = ch;
+}
+
+void writer_printf(Writer *writer, const char *format, ...) {
+  va_list va;
+  const Size space = WRITER_CAPACITY - writer->length;
+  va_start(va, format);
+  const int length = vsnprintf(writer->buffer + writer->length, space, format, va);
+  va_end(va);
+  if (length < 0) {
+    return;
+  }
+  if ((Size)length < space) {
+    writer->length += length;
+    return;
+  }
+  // Did not fit, make room and format again.
+  writer_flush(writer);
+  va_start(va, format);
+  if ((Size)length < WRITER_CAPACITY) {
+    writer->length = vsnprintf(writer->buffer, WRITER_CAPACITY, format, va);
+  } else {
+    vfprintf(writer->fp, format, va);
+  }
+  va_end(va);
+}
+
+void writer_exceptions(Writer *writer, Exception exception) {
+  Bool flag = false;
+  if (exception & EXCEPTION_INVALID) {
+    writer_string(writer, flag ? "|INVALID" : "INVALID"), flag = true;
+  }
+  if (exception & EXCEPTION_INFINITE) {
+    writer_string(writer, flag ? "|INFINITE" : "INFINITE"), flag = true;
+  }
+  if (exception & EXCEPTION_OVERFLOW) {
+    writer_string(writer, flag ? "|OVERFLOW" : "OVERFLOW"), flag = true;
+  }
+  if (exception & EXCEPTION_UNDERFLOW) {
+    writer_string(writer, flag ? "|UNDERFLOW" : "UNDERFLOW"), flag = true;
+  }
+  if (exception & EXCEPTION_INEXACT) {
+    writer_string(writer, flag ? "|INEXACT" : "INEXACT"), flag = true;
+  }
+}
+
+void writer_trap(Writer *writer, const Trap *trap) {
+  static const char *const OPERATIONS[] = {
+    "ADD", "SUB", "MUL", "DIV", "FMA", "FLOOR", "CEIL", "TRUNC", "SQRT"
+  };
+  // The kernels after OPERATION_FMA take one operand.
+  const Size n_operands = trap->operation == OPERATION_FMA ? 3 : trap->operation < OPERATION_FMA ? 2 : 1;
+  switch (writer->format) {
+  case FORMAT_TEXT:
+    writer_printf(writer, "#%u trapped ", trap->node);
+    writer_exceptions(writer, trap->exception);
+    writer_printf(writer, ": %s", OPERATIONS[trap->operation]);
+    for (Size i = 0; i < n_operands; i++) {
+      writer_char(writer, ' ');
+      writer_float32(writer, trap->operands[i]);
+    }
+    writer_string(writer, " = ");
+    writer_float32(writer, trap->result);
+    break;
+  case FORMAT_TSV:
+    writer_printf(writer, "%u\ttrap\t", trap->node);
+    writer_exceptions(writer, trap->exception);
+    writer_printf(writer, "\t%s", OPERATIONS[trap->operation]);
+    for (Size i = 0; i < n_operands; i++) {
+      writer_char(writer, '\t');
+      writer_float32(writer, trap->operands[i]);
+    }
+    writer_char(writer, '\t');
+    writer_float32(writer, trap->result);
+    break;
+  case FORMAT_JSON:
+    writer_printf(writer, "{\"node\":%u,\"trap\":\"", trap->node);
+    writer_exceptions(writer, trap->exception);
+    writer_printf(writer, "\",\"operation\":\"%s\",\"operands\":[", OPERATIONS[trap->operation]);
+    for (Size i = 0; i < n_operands; i++) {
+      if (i) {
+        writer_char(writer, ',');
+      }
+      writer_json_float32(writer, trap->operands[i]);
+    }
+    writer_string(writer, "],\"result\":");
+    writer_json_float32(writer, trap->result);
+    writer_char(writer, '}');
+    break;
+  }
+  writer_char(writer, '\n');
+}
+
+void writer_stats(Writer *writer, const Stats *stats) {
+  static const char *const OPERATIONS[] = {
+    "add", "sub", "mul", "div", "fma", "sqrt", "compare", "convert"
+  };
+  static const char *const EXCEPTIONS[] = {
+    "inexact", "underflow", "overflow", "infinite", "invalid"
+  };
+  static const char *const ROUNDED[] = { "below", "above" };
+  static const char *const SUBNORMAL[] = { "inputs", "outputs" };
+  static const char *const NANS[] = { "propagated" };
+  const Size exceptions[] = {
+    stats_exception(stats, EXCEPTION_INEXACT),
+    stats_exception(stats, EXCEPTION_UNDERFLOW),
+    stats_exception(stats, EXCEPTION_OVERFLOW),
+    stats_exception(stats, EXCEPTION_INFINITE),
+    stats_exception(stats, EXCEPTION_INVALID)
+  };
+  const Size subnormal[] = { stats->subnormal_inputs, stats->subnormal_outputs };
+  const struct {
+    const char *name;
+    const char *const *names;
+    const Size *values;
+    Size count;
+  } GROUPS[] = {
+    { "operations", OPERATIONS, stats->operations, STATS_OPERATIONS },
+    { "exceptions", EXCEPTIONS, exceptions, 5 },
+    { "rounded", ROUNDED, stats->rounded, 2 },
+    { "subnormal", SUBNORMAL, subnormal, 2 },
+    { "nan", NANS, &stats->nans, 1 },
+  };
+  const Size n_groups = sizeof GROUPS / sizeof *GROUPS;
+  if (writer->format == FORMAT_JSON) {
+    writer_string(writer, "{\"stats\":{");
+  }
+  for (Size i = 0; i < n_groups; i++) {
+    switch (writer->format) {
+    case FORMAT_TEXT:
+      writer_printf(writer, "%-10s", GROUPS[i].name);
+      break;
+    case FORMAT_TSV:
+      writer_string(writer, GROUPS[i].name);
+      break;
+    case FORMAT_JSON:
+      writer_printf(writer, "%s\"%s\":{", i ? "," : "", GROUPS[i].name);
+      break;
+    }
+    for (Size j = 0; j < GROUPS[i].count; j++) {
+      const char *name = GROUPS[i].names[j];
+      const unsigned long long value = GROUPS[i].values[j];
+      switch (writer->format) {
+      case FORMAT_TEXT:
+        writer_printf(writer, "  %s: %llu", name, value);
+        break;
+      case FORMAT_TSV:
+        writer_printf(writer, "\t%s\t%llu", name, value);
+        break;
+      case FORMAT_JSON:
+        writer_printf(writer, "%s\"%s\":%llu", j ? "," : "", name, value);
+        break;
+      }
+    }
+    writer_char(writer, writer->format == FORMAT_JSON ? '}' : '\n');
+  }
+  if (writer->format == FORMAT_JSON) {
+    writer_string(writer, "}}\n");
+  }
+}
+
+void writer_json_string(Writer *writer, const char *string) {
+  static const char HEX[] = "0123456789abcdef";
+  writer_char(writer, '"');
+  for (; *string; string++) {
+    const unsigned char ch = *string;
+    if (ch == '"' || ch == '\\') {
+      writer_char(writer, '\\');
+      writer_char(writer, ch);
+    } else if (ch < 0x20) {
+      const char escape[] = { '\\', 'u', '0', '0', HEX[ch >> 4], HEX[ch & 15] };
+      writer_write(writer, escape, sizeof escape);
+    } else {
+      writer_char(writer, ch);
+    }
+  }
+  writer_char(writer, '"');
+}
+
+void writer_float32(Writer *writer, Float32 value) {
+  if (writer->length + DECIMAL_CAPACITY > WRITER_CAPACITY) {
+    writer_flush(writer);
+  }
+  char *buffer = writer->buffer + writer->length;
+  writer->length += writer->notation == NOTATION_HEX
+    ? float32_to_hex(buffer, value)
+    : float32_to_string(buffer, value);
+}
+
+void writer_json_float32(Writer *writer, Float32 value) {
+  const Bool quote = writer->notation == NOTATION_HEX || float32_exp(value) == 0xff;
+  if (quote) {
+    writer_char(writer, '"');
+  }
+  writer_float32(writer, value);
+  if (quote) {
+    writer_char(writer, '"');
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef WRITER_H
+#define WRITER_H
+#include <stdio.h> // FILE
+
+#include "soft.h"
+
+// Buffered output for everything the program renders.
+//
+// Output accumulates in a fixed buffer inside the writer and only reaches the
+// stream when the buffer fills or writer_flush is called, so rendering never
+// allocates and costs one write per WRITER_CAPACITY bytes rather than one per
+// token.
+typedef enum Format Format;
+typedef enum Notation Notation;
+
+typedef struct Writer Writer;
+
+// How results and traces are rendered.
+enum Format {
+  FORMAT_TEXT, ///< Human readable, the default.
+  FORMAT_TSV,  ///< One tab-separated record per line.
+  FORMAT_JSON  ///< One JSON object per line.
+};
+
+// How floating-point values are rendered.
+enum Notation {
+  NOTATION_SHORTEST, ///< Shortest decimal that reads back the same, the default.
+  NOTATION_HEX       ///< Exact hexadecimal floating-point.
+};
+
+#define WRITER_CAPACITY 4096
+
+struct Writer {
+  FILE *fp;
+  Format format;
+  Notation notation;
+  Size length;
+  char buffer[WRITER_CAPACITY];
+};
+
+void writer_init(Writer*, FILE*, Format);
+
+// Write everything buffered to the stream and flush the stream itself.
+Bool writer_flush(Writer*);
+
+void writer_write(Writer*, const char *data, Size length);
+void writer_string(Writer*, const char*);
+void writer_char(Writer*, char);
+void writer_printf(Writer*, const char *format, ...)
+  __attribute__((format(printf, 2, 3)));
+
+// Exception flags as "INVALID|INFINITE|OVERFLOW|UNDERFLOW|INEXACT".
+void writer_exceptions(Writer*, Exception);
+
+// The counters of [stats] in groups, a line per group in text and TSV and a
+// single JSON object otherwise.
+void writer_stats(Writer*, const Stats*);
+
+// A trap as "#NODE trapped FLAG: OP OPERANDS = RESULT" in text, the same
+// fields after "NODE\ttrap" in TSV, or a JSON object on a line.
+void writer_trap(Writer*, const Trap*);
+
+// A JSON string literal of [string], escaped as needed.
+void writer_json_string(Writer*, const char*);
+
+// A float32 in the notation of the writer.
+void writer_float32(Writer*, Float32);
+
+// A float32 as a JSON number, or as a string for infinities, NaNs and the
+// hexadecimal notation which JSON lacks.
+void writer_json_float32(Writer*, Float32);
+
+#endif // WRITER_H